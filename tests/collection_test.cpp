@@ -16,7 +16,7 @@ struct test_cb : public tyrdbs::ushard::meta_callback
     std::shared_ptr<tyrdbs::ushard> ushard;
     uint16_t ushard_id{0};
 
-    void add(const tyrtech::tyrdbs::ushard::slice_ptr& slice) override
+    void add(uint32_t level, const tyrtech::tyrdbs::ushard::slices_t& slices) override
     {
     }
 
@@ -24,9 +24,21 @@ struct test_cb : public tyrdbs::ushard::meta_callback
     {
     }
 
+    void add_segment(const tyrtech::tyrdbs::value_log::segment_ptr& segment) override
+    {
+    }
+
+    void remove_segments(const tyrtech::tyrdbs::value_log::segments_t& segments) override
+    {
+    }
+
     void merge(uint16_t tier) override
     {
     }
+
+    void flush() override
+    {
+    }
 };
 
 
@@ -0,0 +1,131 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+#include <random>
+#include <set>
+
+
+using namespace tyrtech;
+
+
+using keys_t =
+        std::set<std::string>;
+
+
+static constexpr uint32_t max_keys{200000};
+
+
+std::string key_of(uint32_t ndx)
+{
+    return fmt::format("key{:08}", ndx);
+}
+
+
+uint64_t count(const keys_t& keys, const std::string& min_key, const std::string& max_key)
+{
+    return std::distance(keys.lower_bound(min_key), keys.upper_bound(max_key));
+}
+
+
+void write(tyrdbs::ushard* ushard, const std::string& key, uint32_t size, uint64_t idx)
+{
+    std::string value(size, 'v');
+    std::string_view data(value);
+
+    while (data.size() > 3000)
+    {
+        ushard->write(key, data.substr(0, 3000), false, false, idx, 0);
+        data.remove_prefix(3000);
+    }
+
+    ushard->write(key, data, true, false, idx, 0);
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test");
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    std::mt19937 rnd(0);
+
+    keys_t keys;
+    keys_t live;
+
+    for (uint32_t ndx = 0; ndx < max_keys; ndx += 1 + rnd() % 4)
+    {
+        auto key = key_of(ndx);
+
+        uint32_t size = rnd() % 64 == 0 ? rnd() % 20000 : rnd() % 32;
+
+        if (rnd() % 16 == 0)
+        {
+            ushard->write(key, std::string_view(), true, true, 1, 0);
+        }
+        else
+        {
+            write(ushard.get(), key, size, 1);
+            live.insert(key);
+        }
+
+        keys.insert(key);
+    }
+
+    ushard->seal(true, &cb);
+    ushard->flush(&cb);
+
+    auto&& version = ushard->get_version();
+
+    assert(version->size() == 1);
+
+    auto&& slice = (*version)[0];
+
+    assert(slice->count(key_of(0), key_of(max_keys)) == keys.size());
+    assert(ushard->count(key_of(0), key_of(max_keys)) == keys.size());
+    assert(ushard->estimate_count(key_of(0), key_of(max_keys)) == keys.size());
+
+    assert(slice->count(key_of(max_keys), key_of(max_keys + 10)) == 0);
+    assert(ushard->estimate_count(key_of(max_keys), key_of(max_keys + 10)) == 0);
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        uint32_t min_ndx = rnd() % max_keys;
+        uint32_t max_ndx = min_ndx + rnd() % (i % 2 == 0 ? 100 : max_keys);
+
+        auto min_key = key_of(min_ndx);
+        auto max_key = key_of(max_ndx);
+
+        uint64_t expected = count(keys, min_key, max_key);
+
+        assert(slice->count(min_key, max_key) == expected);
+        assert(ushard->count(min_key, max_key) == expected);
+
+        uint64_t estimate = ushard->estimate_count(min_key, max_key);
+        uint64_t error = estimate > expected ? estimate - expected : expected - estimate;
+
+        assert(error <= 400);
+    }
+
+    for (uint32_t ndx = 0; ndx < max_keys; ndx += 2)
+    {
+        ushard->write(key_of(ndx), "value", true, false, 2, 0);
+        live.insert(key_of(ndx));
+    }
+
+    ushard->seal(true, &cb);
+    ushard->flush(&cb);
+
+    ushard->compact(&cb);
+
+    assert(ushard->count(key_of(0), key_of(max_keys)) == live.size());
+    assert(ushard->estimate_count(key_of(0), key_of(max_keys)) == live.size());
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -0,0 +1,317 @@
+#include <common/cmd_line.h>
+#include <common/cpu_sched.h>
+#include <common/clock.h>
+#include <common/logger.h>
+#include <gt/engine.h>
+#include <io/engine.h>
+#include <io/uri.h>
+#include <net/rpc_client.h>
+
+#include <tests/db_server_service.json.h>
+#include <tests/data.json.h>
+
+#include <map>
+
+
+using namespace tyrtech;
+
+
+using records_t =
+        std::map<std::string, std::string>;
+
+
+struct cursor
+{
+    const records_t* records{nullptr};
+
+    std::string key;
+    std::string value;
+
+    std::string last_key;
+    std::string seek_key;
+
+    bool open{false};
+
+    uint32_t count{0};
+
+    records_t::const_iterator next() const
+    {
+        auto it = records->upper_bound(last_key);
+
+        if (seek_key.compare(last_key) > 0)
+        {
+            it = records->lower_bound(seek_key);
+        }
+
+        return it;
+    }
+};
+
+
+void update(net::rpc_client<8192>* c, const records_t& records)
+{
+    uint64_t handle = 0;
+
+    for (auto&& it : records)
+    {
+        auto update_data = c->remote_call<tests::collections::update_data>();
+
+        auto req = update_data.request();
+
+        if (handle != 0)
+        {
+            req.add_handle(handle);
+        }
+
+        auto data = tests::data_builder(req.add_data());
+
+        auto&& dbs = data.add_collections();
+        auto&& db = dbs.add_value();
+        auto&& entries = db.add_entries();
+
+        auto&& entry = entries.add_value();
+
+        entry.set_flags(0x01);
+        entry.add_key(it.first);
+        entry.add_value(it.second);
+        entry.add_ushard(0);
+
+        data.set_flags(0);
+
+        update_data.execute();
+        update_data.wait();
+
+        if (handle == 0)
+        {
+            handle = update_data.response().handle();
+        }
+    }
+
+    auto commit_update = c->remote_call<tests::collections::commit_update>();
+
+    auto req = commit_update.request();
+    req.add_handle(handle);
+
+    commit_update.execute();
+    commit_update.wait();
+}
+
+
+uint64_t fetch(net::rpc_client<8192>* c,
+               uint64_t handle,
+               const std::string_view& min_key,
+               const std::string_view& max_key,
+               cursor* cur)
+{
+    auto fetch_data = c->remote_call<tests::collections::fetch_data>();
+
+    auto req = fetch_data.request();
+
+    if (handle == 0)
+    {
+        req.add_min_key(min_key);
+        req.add_max_key(max_key);
+        req.add_ushard(0);
+    }
+    else
+    {
+        req.add_handle(handle);
+    }
+
+    if (cur->seek_key.size() != 0)
+    {
+        req.add_seek_key(cur->seek_key);
+    }
+
+    fetch_data.execute();
+    fetch_data.wait();
+
+    auto res = fetch_data.response();
+
+    if (res.has_data() == false)
+    {
+        assert(res.has_handle() == false);
+        assert(cur->open == false);
+        assert(cur->next() == cur->records->end());
+
+        return 0;
+    }
+
+    tests::data_parser data(res.get_parser(), res.data());
+
+    auto&& dbs = data.collections();
+
+    assert(dbs.next() == true);
+    auto&& db = dbs.value();
+
+    auto&& entries = db.entries();
+
+    while (entries.next() == true)
+    {
+        auto&& entry = entries.value();
+
+        if (cur->open == true)
+        {
+            assert(cur->key == entry.key());
+            cur->value.append(entry.value());
+        }
+        else
+        {
+            auto it = cur->next();
+
+            assert(it != cur->records->end());
+            assert(it->first == entry.key());
+
+            cur->key.assign(entry.key());
+            cur->value.assign(entry.value());
+
+            cur->last_key = cur->key;
+            cur->seek_key.clear();
+
+            cur->open = true;
+        }
+
+        if ((entry.flags() & 0x01) == 0x01)
+        {
+            assert(cur->value == cur->records->at(cur->key));
+
+            cur->open = false;
+            cur->count++;
+        }
+    }
+
+    if (res.has_handle() == false)
+    {
+        assert(cur->open == false);
+        assert(cur->next() == cur->records->end());
+
+        return 0;
+    }
+
+    return res.handle();
+}
+
+
+void seek_thread(const std::string_view& uri, uint32_t keys, uint32_t value_size)
+{
+    net::rpc_client<8192> c(io::uri::connect(uri, 0));
+
+    auto prefix = fmt::format("seek{:016x}", clock::now());
+
+    records_t records;
+
+    for (uint32_t ndx = 0; ndx < keys; ndx++)
+    {
+        auto key = fmt::format("{}{:06}", prefix, ndx);
+        auto value = fmt::format("{}{}", ndx, std::string(value_size + ndx % 7, 'a' + ndx % 26));
+
+        records[key] = value;
+    }
+
+    update(&c, records);
+
+    for (uint32_t step : {0, 1, 3})
+    {
+        cursor cur;
+        cur.records = &records;
+
+        auto&& min_key = records.begin()->first;
+        auto&& max_key = records.rbegin()->first;
+
+        uint64_t handle = fetch(&c, 0, min_key, max_key, &cur);
+
+        uint32_t fetches = 0;
+        uint32_t open_seeks = 0;
+
+        while (handle != 0)
+        {
+            switch (fetches++ % 3)
+            {
+                case 0:
+                    break;
+                case 1:
+                    cur.seek_key = cur.last_key;
+                    break;
+                case 2:
+                {
+                    uint32_t ndx = std::stoul(cur.last_key.substr(prefix.size()));
+                    cur.seek_key = fmt::format("{}{:06}", prefix, ndx + step);
+
+                    if (cur.open == true && step != 0)
+                    {
+                        open_seeks++;
+                    }
+
+                    break;
+                }
+            }
+
+            handle = fetch(&c, handle, min_key, max_key, &cur);
+        }
+
+        assert(open_seeks != 0 || step == 0);
+
+        logger::notice("step {}: {} records in {} fetches, {} seeks after a partial record",
+                       step,
+                       cur.count,
+                       fetches + 1,
+                       open_seeks);
+    }
+
+    gt::terminate();
+}
+
+
+int main(int argc, const char* argv[])
+{
+    cmd_line cmd(argv[0], "Network seek client test.", nullptr);
+
+    cmd.add_param("network-queue-depth",
+                  nullptr,
+                  "network-queue-depth",
+                  "num",
+                  "512",
+                  {"network queue depth to use (default is 512)"});
+
+    cmd.add_param("cpu",
+                  nullptr,
+                  "cpu",
+                  "index",
+                  "0",
+                  {"cpu index to run the program on (default is 0)"});
+
+    cmd.add_param("keys",
+                  nullptr,
+                  "keys",
+                  "num",
+                  "256",
+                  {"keys to write and seek over (default: 256)"});
+
+    cmd.add_param("value-size",
+                  nullptr,
+                  "value-size",
+                  "bytes",
+                  "3000",
+                  {"size of values to write (default: 3000)"});
+
+    cmd.add_param("uri",
+                  "<uri>",
+                  {"uri to connect to"});
+
+    cmd.parse(argc, argv);
+
+    set_cpu(cmd.get<uint32_t>("cpu"));
+
+    gt::initialize();
+    io::initialize(4096);
+    io::channel::initialize(cmd.get<uint32_t>("network-queue-depth"));
+
+    gt::create_thread(seek_thread,
+                      cmd.get<std::string_view>("uri"),
+                      cmd.get<uint32_t>("keys"),
+                      cmd.get<uint32_t>("value-size"));
+
+    gt::run();
+
+    return 0;
+}
@@ -7,6 +7,9 @@
 #include <io/uri.h>
 #include <net/rpc_server.h>
 #include <tyrdbs/ushard.h>
+#include <tyrdbs/chunk.h>
+#include <tyrdbs/manifest.h>
+#include <tyrdbs/wal.h>
 #include <tyrdbs/cache.h>
 
 #include <tests/db_server_service.json.h>
@@ -15,6 +18,9 @@
 #include <tests/snapshot.json.h>
 
 #include <crc32c.h>
+#include <unistd.h>
+#include <cstring>
+#include <set>
 
 
 using namespace tyrtech;
@@ -32,7 +38,7 @@ struct impl : private disallow_copy
     {
         struct impl* impl;
 
-        tyrdbs::ushard::slices_t snapshot;
+        tyrdbs::ushard::version_ptr snapshot;
 
         context(struct impl* impl)
           : impl(impl)
@@ -80,27 +86,48 @@ struct impl : private disallow_copy
         {
         }
 
-        void add(const tyrtech::tyrdbs::ushard::slice_ptr& slice) override
+        void add(uint32_t level, const tyrtech::tyrdbs::ushard::slices_t& slices) override
         {
+            impl->manifest.add(std::string_view(), ushard, level, slices);
         }
 
         void remove(const tyrtech::tyrdbs::ushard::slices_t& slices) override
         {
+            impl->manifest.remove(std::string_view(), ushard, slices);
+
             for (auto&& slice : slices)
             {
                 slice->unlink();
             }
         }
 
+        void add_segment(const tyrtech::tyrdbs::value_log::segment_ptr& segment) override
+        {
+            impl->manifest.add_segment(std::string_view(), ushard, segment);
+        }
+
+        void remove_segments(const tyrtech::tyrdbs::value_log::segments_t& segments) override
+        {
+            impl->manifest.remove_segments(std::string_view(), ushard, segments);
+        }
+
         void merge(uint16_t tier) override
         {
             impl->merge_requests.push(merge_request_t(ushard, tier));
             impl->merge_cond.signal();
         }
+
+        void flush() override
+        {
+            impl->flush_requests.push(ushard);
+            impl->flush_cond.signal();
+        }
     };
 
     void merge_thread()
     {
+        gt::set_background(true);
+
         while (true)
         {
             if (merge_requests.empty() == false)
@@ -137,6 +164,56 @@ struct impl : private disallow_copy
         }
     }
 
+    void flush_thread()
+    {
+        while (true)
+        {
+            if (flush_requests.empty() == false)
+            {
+                auto ushard_id = flush_requests.pop();
+
+                cb cb(ushard_id, this);
+                ushards[ushard_id]->flush(&cb);
+
+                gt::yield();
+            }
+            else
+            {
+                if (gt::terminated() == true)
+                {
+                    break;
+                }
+                else
+                {
+                    flush_cond.wait();
+                }
+            }
+        }
+    }
+
+    void checkpoint()
+    {
+        uint64_t lsn = pending_lsns.size() != 0 ? *pending_lsns.begin() - 1 : wal.last_lsn();
+
+        for (auto&& it : ushards)
+        {
+            cb cb(it.first, this);
+
+            it.second->expire(&cb);
+            it.second->seal(true, &cb);
+        }
+
+        for (auto&& it : ushards)
+        {
+            cb cb(it.first, this);
+            it.second->flush(&cb);
+        }
+
+        wal.checkpoint(lsn);
+
+        checkpoint_active = false;
+    }
+
     template<typename T>
     uint64_t id(const T& obj)
     {
@@ -156,6 +233,10 @@ struct impl : private disallow_copy
 
             writer w;
             w.idx = idx++;
+            w.expires = ttl != 0 ? tyrdbs::ushard::now() + ttl : 0;
+
+            log_write(&w.log, w.idx);
+            log_write(&w.log, w.expires);
 
             update_entries(request.get_parser(), request.data(), &w);
 
@@ -175,11 +256,24 @@ struct impl : private disallow_copy
     {
         auto& w = writers[request.handle()];
 
-        for (auto&& slice : w.slices)
+        if (w.open_records.size() != 0)
         {
-            cb cb(slice.first, this);
+            throw tyrdbs::slice_writer::invalid_data_error("key eor mismatch");
+        }
+
+        uint64_t lsn = wal.append(w.log);
+        pending_lsns.insert(lsn);
+
+        wal.commit(lsn);
 
-            ushards[slice.first]->add(slice.second->commit(), &cb);
+        apply(w.log, false);
+
+        pending_lsns.erase(lsn);
+
+        if (wal.size() >= max_wal_size && checkpoint_active == false)
+        {
+            checkpoint_active = true;
+            gt::create_thread(&impl::checkpoint, this);
         }
 
         writers.erase(request.handle());
@@ -200,35 +294,58 @@ struct impl : private disallow_copy
         {
             auto&& ushard = ushards[request.ushard() % ushards.size()];
 
-            auto&& it = ushard->range(request.min_key(), request.max_key());
-            uint64_t handle = id(it);
+            std::unique_ptr<tyrdbs::iterator> it;
 
-            if (it->next() == true)
+            if (request.min_key().compare(request.max_key()) == 0)
             {
-                reader r;
-                r.iterator = std::move(it);
-                r.value_part = r.iterator->value();
+                it = ushard->get(request.min_key());
+            }
+            else
+            {
+                it = ushard->range(request.min_key(), request.max_key());
+            }
 
-                if (fetch_entries(&r, response->add_data()) == false)
-                {
-                    readers[handle] = std::move(r);
-                    response->add_handle(handle);
-                }
+            if (request.has_seek_key() == true)
+            {
+                seek_fetch(std::move(it), request.seek_key(), response);
             }
+            else
+            {
+                start_fetch(std::move(it), response);
+            }
+        }
+        else if (request.has_seek_key() == true)
+        {
+            seek_fetch(request.handle(), request.seek_key(), response);
         }
         else
         {
-            auto& r = readers[request.handle()];
-            uint64_t handle = id(r.iterator);
+            continue_fetch(request.handle(), response);
+        }
+    }
 
-            if (fetch_entries(&r, response->add_data()) == true)
-            {
-                readers.erase(handle);
-            }
-            else
+    void multi_get(const multi_get::request_parser_t& request,
+                   multi_get::response_builder_t* response,
+                   context* ctx)
+    {
+        if (request.has_handle() == false)
+        {
+            auto&& ushard = ushards[request.ushard() % ushards.size()];
+
+            tyrdbs::slice::key_views_t keys;
+
+            auto&& keys_parser = request.keys();
+
+            while (keys_parser.next() == true)
             {
-                response->add_handle(handle);
+                keys.push_back(keys_parser.value());
             }
+
+            start_fetch(ushard->multi_get(std::move(keys)), response);
+        }
+        else
+        {
+            continue_fetch(request.handle(), response);
         }
     }
 
@@ -244,14 +361,14 @@ struct impl : private disallow_copy
                   context* ctx)
     {
         auto& ushard = ushards[request.ushard()];
-        ctx->snapshot = ushard->get_slices();
+        ctx->snapshot = ushard->get_version();
 
         auto&& snapshot = tests::snapshot_builder(response->add_snapshot());
         snapshot.add_path(storage::path());
 
         auto&& slices = snapshot.add_slices();
 
-        for (auto&& c : ctx->snapshot)
+        for (auto&& c : *ctx->snapshot)
         {
             auto&& slice = slices.add_value();
             auto&& extents = slice.add_extents();
@@ -263,6 +380,69 @@ struct impl : private disallow_copy
         }
     }
 
+    void ingest_data(const ingest_data::request_parser_t& request,
+                     ingest_data::response_builder_t* response,
+                     context* ctx)
+    {
+        if (request.has_handle() == false)
+        {
+            ingest i;
+            i.idx = idx++;
+            i.expires = ttl != 0 ? tyrdbs::ushard::now() + ttl : 0;
+
+            ingest_entries(request.get_parser(), request.data(), &i);
+
+            uint64_t handle = i.idx;
+
+            ingests[handle] = std::move(i);
+            response->add_handle(handle);
+        }
+        else
+        {
+            auto& i = ingests[request.handle()];
+            ingest_entries(request.get_parser(), request.data(), &i);
+        }
+    }
+
+    void commit_ingest(const commit_ingest::request_parser_t& request,
+                       commit_ingest::response_builder_t* response,
+                       context* ctx)
+    {
+        auto i = std::move(ingests[request.handle()]);
+        ingests.erase(request.handle());
+
+        for (auto&& it : i.ingesters)
+        {
+            cb cb(it.first, this);
+            it.second->commit(&cb);
+        }
+    }
+
+    void abort_ingest(const abort_ingest::request_parser_t& request,
+                      abort_ingest::response_builder_t* response,
+                      context* ctx)
+    {
+        ingests.erase(request.handle());
+    }
+
+    // Both counts cover flushed slices only; memtables are not included.
+    // Every version of a key and every tombstone counts as a separate key.
+    void estimate_count(const estimate_count::request_parser_t& request,
+                        estimate_count::response_builder_t* response,
+                        context* ctx)
+    {
+        auto&& ushard = ushards[request.ushard() % ushards.size()];
+        response->add_count(ushard->estimate_count(request.min_key(), request.max_key()));
+    }
+
+    void count(const count::request_parser_t& request,
+               count::response_builder_t* response,
+               context* ctx)
+    {
+        auto&& ushard = ushards[request.ushard() % ushards.size()];
+        response->add_count(ushard->count(request.min_key(), request.max_key()));
+    }
+
     void print_stats()
     {
         logger::notice("capacity:    {}", storage::capacity());
@@ -270,17 +450,64 @@ struct impl : private disallow_copy
         logger::notice("free blocks: {}", storage::capacity() - storage::size());
     }
 
+    struct replay_cb : public tyrdbs::wal::replay_callback
+    {
+        struct impl* impl{nullptr};
+
+        replay_cb(struct impl* impl)
+          : impl(impl)
+        {
+        }
+
+        void replay(uint64_t lsn, const std::string_view& record) override
+        {
+            impl->apply(record, true);
+        }
+    };
+
     impl(uint32_t merge_threads,
          uint32_t ushards_num,
-         uint32_t max_slices)
+         uint32_t max_slices,
+         uint32_t ttl,
+         uint32_t value_threshold,
+         const std::string_view& wal_path,
+         tyrdbs::compaction_policy::type policy,
+         bool time_series)
       : max_slices(max_slices)
+      , ttl(ttl)
+      , wal(wal_path)
     {
         for (uint32_t i = 0; i < ushards_num; i++)
         {
-            ushards[i] = std::make_shared<tyrdbs::ushard>();
+            auto&& ushard_policy = tyrdbs::compaction_policy::create(policy);
+
+            ushards[i] = std::make_shared<tyrdbs::ushard>(std::move(ushard_policy));
+
+            if (time_series == true)
+            {
+                ushards[i]->set_merge_operator(std::make_shared<tyrdbs::chunk_merge_operator>());
+            }
+
+            ushards[i]->set_value_threshold(value_threshold);
+
             tier_locks[i] = std::make_shared<tier_locks_t>();
+
+            manifest.restore(std::string_view(), i, ushards[i].get());
+
+            for (auto&& slice : ushards[i]->get_slices())
+            {
+                idx = std::max(idx, slice->max_idx() + 1);
+            }
         }
 
+        replay_cb cb(this);
+        wal.replay(&cb);
+
+        checkpoint_active = true;
+        gt::create_thread(&impl::checkpoint, this);
+
+        gt::create_thread(&impl::flush_thread, this);
+
         for (uint32_t i = 0; i < merge_threads; i++)
         {
             gt::create_thread(&impl::merge_thread, this);
@@ -288,22 +515,90 @@ struct impl : private disallow_copy
     }
 
 private:
-    using slice_ptr =
-            std::shared_ptr<tyrdbs::slice_writer>;
+    static constexpr uint64_t max_wal_size{256UL << 20};
 
-    using slices_t =
-            std::unordered_map<uint32_t, slice_ptr>;
+private:
+    using open_records_t =
+            std::unordered_map<uint32_t, std::string>;
 
     struct writer
     {
-        slices_t slices;
         uint64_t idx{0};
+        uint32_t expires{0};
+
+        std::string log;
+        open_records_t open_records;
+    };
+
+    class log_reader
+    {
+    public:
+        template<typename T>
+        T read()
+        {
+            T value;
+
+            std::memcpy(&value, consume(sizeof(T)), sizeof(T));
+
+            return value;
+        }
+
+        std::string_view read_string()
+        {
+            uint16_t size = read<uint16_t>();
+            return std::string_view(consume(size), size);
+        }
+
+        bool empty() const
+        {
+            return m_data.size() == 0;
+        }
+
+    public:
+        log_reader(const std::string_view& data)
+          : m_data(data)
+        {
+        }
+
+    private:
+        std::string_view m_data;
+
+    private:
+        const char* consume(uint32_t size)
+        {
+            if (m_data.size() < size)
+            {
+                throw runtime_error("invalid log record");
+            }
+
+            const char* data = m_data.data();
+            m_data.remove_prefix(size);
+
+            return data;
+        }
+    };
+
+    using ingester_ptr =
+            std::unique_ptr<tyrdbs::ushard::ingester>;
+
+    using ingesters_t =
+            std::unordered_map<uint32_t, ingester_ptr>;
+
+    struct ingest
+    {
+        uint64_t idx{0};
+        uint32_t expires{0};
+
+        ingesters_t ingesters;
     };
 
     struct reader
     {
         std::unique_ptr<tyrdbs::iterator> iterator;
         std::string_view value_part;
+
+        std::string seek_key;
+        bool open{false};
     };
 
     using writers_t =
@@ -312,16 +607,30 @@ private:
     using readers_t =
             std::unordered_map<uint64_t, reader>;
 
+    using ingests_t =
+            std::unordered_map<uint64_t, ingest>;
+
     uint32_t max_slices{0};
+    uint32_t ttl{0};
 
     uint64_t idx{0};
 
+    tyrdbs::manifest manifest;
+    tyrdbs::wal wal;
+
+    std::set<uint64_t> pending_lsns;
+    bool checkpoint_active{false};
+
     writers_t writers;
     readers_t readers;
+    ingests_t ingests;
 
     ring_queue<merge_request_t> merge_requests;
     gt::condition merge_cond;
 
+    ring_queue<uint32_t> flush_requests;
+    gt::condition flush_cond;
+
     using tier_locks_t =
             std::unordered_set<uint32_t>;
 
@@ -342,6 +651,82 @@ private:
     ushards_t ushards;
 
 private:
+    template<typename ResponseBuilder>
+    void start_fetch(std::unique_ptr<tyrdbs::iterator> it, ResponseBuilder* response)
+    {
+        if (it->next() == true)
+        {
+            fetch(std::move(it), response);
+        }
+    }
+
+    template<typename ResponseBuilder>
+    void seek_fetch(std::unique_ptr<tyrdbs::iterator> it,
+                    const std::string_view& key,
+                    ResponseBuilder* response)
+    {
+        if (it->seek(key) == true)
+        {
+            fetch(std::move(it), response);
+        }
+    }
+
+    template<typename ResponseBuilder>
+    void seek_fetch(uint64_t request_handle,
+                    const std::string_view& key,
+                    ResponseBuilder* response)
+    {
+        auto& r = readers[request_handle];
+
+        if (r.open == true)
+        {
+            r.seek_key.assign(key);
+        }
+        else if (r.iterator->key().compare(key) < 0)
+        {
+            auto it = std::move(r.iterator);
+            readers.erase(request_handle);
+
+            seek_fetch(std::move(it), key, response);
+
+            return;
+        }
+
+        continue_fetch(request_handle, response);
+    }
+
+    template<typename ResponseBuilder>
+    void fetch(std::unique_ptr<tyrdbs::iterator> it, ResponseBuilder* response)
+    {
+        uint64_t handle = id(it);
+
+        reader r;
+        r.iterator = std::move(it);
+        r.value_part = r.iterator->value();
+
+        if (fetch_entries(&r, response->add_data()) == false)
+        {
+            readers[handle] = std::move(r);
+            response->add_handle(handle);
+        }
+    }
+
+    template<typename ResponseBuilder>
+    void continue_fetch(uint64_t request_handle, ResponseBuilder* response)
+    {
+        auto& r = readers[request_handle];
+        uint64_t handle = id(r.iterator);
+
+        if (fetch_entries(&r, response->add_data()) == true)
+        {
+            readers.erase(handle);
+        }
+        else
+        {
+            response->add_handle(handle);
+        }
+    }
+
     bool fetch_entries(reader* r, message::builder* builder)
     {
         uint8_t data_flags = 0;
@@ -400,13 +785,15 @@ private:
             entry.add_key(key);
             entry.add_value(r->value_part.substr(0, part_size));
 
+            r->open = (entry_flags & 0x01) == 0;
+
             if (part_size != r->value_part.size())
             {
                 r->value_part = r->value_part.substr(part_size);
                 break;
             }
 
-            if (r->iterator->next() == false)
+            if (advance(r) == false)
             {
                 data_flags |= 0x01;
                 break;
@@ -420,6 +807,22 @@ private:
         return (data_flags & 0x01) == 0x01;
     }
 
+    bool advance(reader* r)
+    {
+        if (r->open == false && r->seek_key.size() != 0)
+        {
+            auto key = std::move(r->seek_key);
+            r->seek_key.clear();
+
+            if (r->iterator->key().compare(key) < 0)
+            {
+                return r->iterator->seek(key);
+            }
+        }
+
+        return r->iterator->next();
+    }
+
     void update_entries(const message::parser* p, uint16_t off, writer* w)
     {
         tests::data_parser data(p, off);
@@ -438,32 +841,141 @@ private:
             bool eor = entry.flags() & 0x01;
             bool deleted = entry.flags() & 0x02;
 
-            auto&& slice = w->slices[entry.ushard() % ushards.size()];
+            tyrdbs::ushard::check(entry.key(), entry.value(), eor, deleted);
+
+            uint32_t ushard = entry.ushard() % ushards.size();
 
-            if (slice == nullptr)
+            if (auto it = w->open_records.find(ushard); it != w->open_records.end())
             {
-                slice = std::make_unique<tyrdbs::slice_writer>();
+                if (it->second.compare(entry.key()) != 0)
+                {
+                    throw tyrdbs::slice_writer::invalid_data_error("key eor mismatch");
+                }
+
+                if (eor == true)
+                {
+                    w->open_records.erase(it);
+                }
+            }
+            else if (eor == false)
+            {
+                w->open_records[ushard].assign(entry.key());
             }
 
-            slice->add(entry.key(), entry.value(), eor, deleted, w->idx);
+            log_write(&w->log, entry.ushard());
+            log_write(&w->log, entry.flags());
+            log_write(&w->log, entry.key());
+            log_write(&w->log, entry.value());
         }
+    }
 
-        if ((data.flags() & 0x01) == 0x01)
+    void ingest_entries(const message::parser* p, uint16_t off, ingest* i)
+    {
+        tests::data_parser data(p, off);
+
+        auto&& dbs = data.collections();
+
+        assert(dbs.next() == true);
+        auto&& db = dbs.value();
+
+        auto&& entries = db.entries();
+
+        while (entries.next() == true)
         {
-            auto jobs = gt::async::create_jobs();
+            auto&& entry = entries.value();
+
+            bool eor = entry.flags() & 0x01;
+            bool deleted = entry.flags() & 0x02;
+
+            tyrdbs::ushard::check(entry.key(), entry.value(), eor, deleted);
 
-            for (auto&& slice : w->slices)
+            uint32_t ushard = entry.ushard() % ushards.size();
+
+            auto& ingester = i->ingesters[ushard];
+
+            if (ingester == nullptr)
             {
-                auto f = [slice]
-                {
-                    slice.second->flush();
-                };
+                ingester = ushards[ushard]->ingest();
+            }
 
-                jobs.run(std::move(f));
+            ingester->add(entry.key(), entry.value(), eor, deleted, i->idx, i->expires);
+        }
+    }
+
+    void apply(const std::string_view& record, bool replay)
+    {
+        log_reader reader(record);
+
+        uint64_t record_idx = reader.read<uint64_t>();
+        uint32_t record_expires = reader.read<uint32_t>();
+
+        std::unordered_set<uint32_t> written;
+        std::unordered_set<uint32_t> applied;
+
+        while (reader.empty() == false)
+        {
+            uint32_t ushard = reader.read<uint32_t>() % ushards.size();
+            uint8_t flags = reader.read<uint8_t>();
+
+            auto key = reader.read_string();
+            auto value = reader.read_string();
+
+            if (applied.find(ushard) != applied.end())
+            {
+                continue;
             }
 
-            jobs.wait();
+            if (written.insert(ushard).second == true)
+            {
+                if (replay == true && contains(ushards[ushard], key, record_idx) == true)
+                {
+                    applied.insert(ushard);
+                    continue;
+                }
+            }
+
+            ushards[ushard]->write(key,
+                                   value,
+                                   (flags & 0x01) != 0,
+                                   (flags & 0x02) != 0,
+                                   record_idx,
+                                   record_expires);
         }
+
+        for (auto&& ushard : written)
+        {
+            cb cb(ushard, this);
+            ushards[ushard]->seal(false, &cb);
+        }
+
+        idx = std::max(idx, record_idx + 1);
+    }
+
+    static bool contains(const ushard_ptr& ushard, const std::string_view& key, uint64_t idx)
+    {
+        auto&& it = ushard->range(key, key);
+
+        while (it->next() == true)
+        {
+            if (it->idx() == idx)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template<typename T>
+    static void log_write(std::string* log, const T& value)
+    {
+        log->append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static void log_write(std::string* log, const std::string_view& value)
+    {
+        log_write(log, static_cast<uint16_t>(value.size()));
+        log->append(value.data(), value.size());
     }
 };
 
@@ -523,6 +1035,34 @@ int main(int argc, const char* argv[])
                   "4096",
                   {"maximum number of slices allowed (default is 4096)"});
 
+    cmd.add_param("ttl",
+                  nullptr,
+                  "ttl",
+                  "sec",
+                  "0",
+                  {"time to live of written entries (default is 0, never expire)"});
+
+    cmd.add_param("value-threshold",
+                  nullptr,
+                  "value-threshold",
+                  "bytes",
+                  "0",
+                  {"size above which values are kept in the value log (default is 0, disabled)"});
+
+    cmd.add_param("merge-io-rate",
+                  nullptr,
+                  "merge-io-rate",
+                  "pages",
+                  "0",
+                  {"maximum merge I/O rate in pages per second (default is 0, unlimited)"});
+
+    cmd.add_param("target-read-latency",
+                  nullptr,
+                  "target-read-latency",
+                  "usec",
+                  "2000",
+                  {"read latency above which merge I/O is throttled (default is 2000)"});
+
     cmd.add_param("cache-bits",
                   nullptr,
                   "cache-bits",
@@ -556,6 +1096,23 @@ int main(int argc, const char* argv[])
                   "storage.dat",
                   {"storage file to use (default storage.dat)"});
 
+    cmd.add_param("wal-path",
+                  nullptr,
+                  "wal-path",
+                  "path",
+                  "wal",
+                  {"write-ahead log directory to use (default wal)"});
+
+    cmd.add_flag("leveled",
+                 nullptr,
+                 "leveled",
+                 {"use leveled compaction instead of size-tiered"});
+
+    cmd.add_flag("time-series",
+                 nullptr,
+                 "time-series",
+                 {"treat values as gorilla encoded time-series chunks and merge them"});
+
     cmd.add_param("uri",
                   "<uri>",
                   {"uri to listen on"});
@@ -574,14 +1131,28 @@ int main(int argc, const char* argv[])
 
     tyrdbs::cache::initialize(cmd.get<uint32_t>("block-cache-bits"));
 
-    storage::initialize(io::file::create(cmd.get<std::string_view>("storage-file")),
+    auto&& storage_file = cmd.get<std::string_view>("storage-file");
+
+    storage::initialize(access(storage_file.data(), F_OK) == 0 ?
+                                io::file::open(io::file::access::read_write, storage_file) :
+                                io::file::create(storage_file),
                         cmd.get<uint32_t>("cache-bits"),
                         cmd.get<uint32_t>("write-cache-bits"),
                         cmd.flag("preallocate-space"));
 
+    storage::limit_background_io(cmd.get<uint64_t>("merge-io-rate"),
+                                 cmd.get<uint64_t>("target-read-latency") * 1000);
+
     module::impl impl(cmd.get<uint32_t>("merge-threads"),
                       cmd.get<uint32_t>("ushards"),
-                      cmd.get<uint32_t>("max-slices"));
+                      cmd.get<uint32_t>("max-slices"),
+                      cmd.get<uint32_t>("ttl"),
+                      cmd.get<uint32_t>("value-threshold"),
+                      cmd.get<std::string_view>("wal-path"),
+                      cmd.flag("leveled") ?
+                              tyrdbs::compaction_policy::type::leveled :
+                              tyrdbs::compaction_policy::type::tiered,
+                      cmd.flag("time-series"));
 
     db_server_service_t srv(&impl);
 
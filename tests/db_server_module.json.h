@@ -235,7 +235,7 @@ struct response_parser final : public tyrtech::message::struct_parser<0, 0>
 namespace messages::fetch_data {
 
 
-struct request_builder final : public tyrtech::message::struct_builder<4, 0>
+struct request_builder final : public tyrtech::message::struct_builder<5, 0>
 {
     request_builder(tyrtech::message::builder* builder)
       : struct_builder(builder)
@@ -245,7 +245,7 @@ struct request_builder final : public tyrtech::message::struct_builder<4, 0>
     void add_handle(const uint64_t& value)
     {
         set_offset<0>();
-        struct_builder<4, 0>::add_value(value);
+        struct_builder<5, 0>::add_value(value);
     }
 
     static constexpr uint16_t handle_bytes_required()
@@ -256,7 +256,7 @@ struct request_builder final : public tyrtech::message::struct_builder<4, 0>
     void add_min_key(const std::string_view& value)
     {
         set_offset<1>();
-        struct_builder<4, 0>::add_value(value);
+        struct_builder<5, 0>::add_value(value);
     }
 
     static constexpr uint16_t min_key_bytes_required()
@@ -267,7 +267,7 @@ struct request_builder final : public tyrtech::message::struct_builder<4, 0>
     void add_max_key(const std::string_view& value)
     {
         set_offset<2>();
-        struct_builder<4, 0>::add_value(value);
+        struct_builder<5, 0>::add_value(value);
     }
 
     static constexpr uint16_t max_key_bytes_required()
@@ -278,16 +278,27 @@ struct request_builder final : public tyrtech::message::struct_builder<4, 0>
     void add_ushard(const uint32_t& value)
     {
         set_offset<3>();
-        struct_builder<4, 0>::add_value(value);
+        struct_builder<5, 0>::add_value(value);
     }
 
     static constexpr uint16_t ushard_bytes_required()
     {
         return tyrtech::message::element<uint32_t>::size;
     }
+
+    void add_seek_key(const std::string_view& value)
+    {
+        set_offset<4>();
+        struct_builder<5, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t seek_key_bytes_required()
+    {
+        return tyrtech::message::element<std::string_view>::size;
+    }
 };
 
-struct request_parser final : public tyrtech::message::struct_parser<4, 0>
+struct request_parser final : public tyrtech::message::struct_parser<5, 0>
 {
     request_parser(const tyrtech::message::parser* parser, uint16_t offset)
       : struct_parser(parser, offset)
@@ -335,6 +346,16 @@ struct request_parser final : public tyrtech::message::struct_parser<4, 0>
     {
         return tyrtech::message::element<uint32_t>().parse(m_parser, offset<3>());
     }
+
+    bool has_seek_key() const
+    {
+        return has_offset<4>();
+    }
+
+    decltype(auto) seek_key() const
+    {
+        return tyrtech::message::element<std::string_view>().parse(m_parser, offset<4>());
+    }
 };
 
 struct response_builder final : public tyrtech::message::struct_builder<2, 0>
@@ -397,90 +418,733 @@ struct response_parser final : public tyrtech::message::struct_parser<2, 0>
 namespace messages::abort_fetch {
 
 
-struct request_builder final : public tyrtech::message::struct_builder<1, 0>
+struct request_builder final : public tyrtech::message::struct_builder<1, 0>
+{
+    request_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_handle(const uint64_t& value)
+    {
+        set_offset<0>();
+        struct_builder<1, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t handle_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
+    }
+};
+
+struct request_parser final : public tyrtech::message::struct_parser<1, 0>
+{
+    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    request_parser() = default;
+
+    bool has_handle() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) handle() const
+    {
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
+    }
+};
+
+struct response_builder final : public tyrtech::message::struct_builder<0, 0>
+{
+    response_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+};
+
+struct response_parser final : public tyrtech::message::struct_parser<0, 0>
+{
+    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    response_parser() = default;
+};
+
+}
+
+namespace messages::snapshot {
+
+
+struct request_builder final : public tyrtech::message::struct_builder<2, 0>
+{
+    request_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_collection(const std::string_view& value)
+    {
+        set_offset<0>();
+        struct_builder<2, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t collection_bytes_required()
+    {
+        return tyrtech::message::element<std::string_view>::size;
+    }
+
+    void add_ushard(const uint32_t& value)
+    {
+        set_offset<1>();
+        struct_builder<2, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t ushard_bytes_required()
+    {
+        return tyrtech::message::element<uint32_t>::size;
+    }
+};
+
+struct request_parser final : public tyrtech::message::struct_parser<2, 0>
+{
+    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    request_parser() = default;
+
+    bool has_collection() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) collection() const
+    {
+        return tyrtech::message::element<std::string_view>().parse(m_parser, offset<0>());
+    }
+
+    bool has_ushard() const
+    {
+        return has_offset<1>();
+    }
+
+    decltype(auto) ushard() const
+    {
+        return tyrtech::message::element<uint32_t>().parse(m_parser, offset<1>());
+    }
+};
+
+struct response_builder final : public tyrtech::message::struct_builder<1, 0>
+{
+    response_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    decltype(auto) add_snapshot()
+    {
+        set_offset<0>();
+        return m_builder;
+    }
+};
+
+struct response_parser final : public tyrtech::message::struct_parser<1, 0>
+{
+    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    response_parser() = default;
+
+    bool has_snapshot() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) snapshot() const
+    {
+        return offset<0>();
+    }
+};
+
+}
+
+namespace messages::multi_get {
+
+
+struct request_builder final : public tyrtech::message::struct_builder<3, 0>
+{
+    struct keys_builder final : public tyrtech::message::list_builder
+    {
+        keys_builder(tyrtech::message::builder* builder)
+          : list_builder(builder)
+        {
+        }
+
+        void add_value(const std::string_view& value)
+        {
+            add_element();
+            list_builder::add_value(value);
+        }
+    };
+
+    request_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_handle(const uint64_t& value)
+    {
+        set_offset<0>();
+        struct_builder<3, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t handle_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
+    }
+
+    decltype(auto) add_keys()
+    {
+        set_offset<1>();
+        return keys_builder(m_builder);
+    }
+
+    static constexpr uint16_t keys_bytes_required()
+    {
+        return keys_builder::bytes_required();
+    }
+
+    void add_ushard(const uint32_t& value)
+    {
+        set_offset<2>();
+        struct_builder<3, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t ushard_bytes_required()
+    {
+        return tyrtech::message::element<uint32_t>::size;
+    }
+};
+
+struct request_parser final : public tyrtech::message::struct_parser<3, 0>
+{
+    struct keys_parser final : public tyrtech::message::list_parser
+    {
+        keys_parser(const tyrtech::message::parser* parser, uint16_t offset)
+          : list_parser(parser, offset)
+        {
+        }
+
+        bool next()
+        {
+            if (m_elements == 0)
+            {
+                return false;
+            }
+
+            m_elements--;
+
+            m_offset += m_element_size;
+
+            m_element_size = tyrtech::message::element<uint16_t>().parse(m_parser, m_offset);
+            m_element_size += tyrtech::message::element<uint16_t>::size;
+
+            return true;
+        }
+
+        decltype(auto) value() const
+        {
+            return tyrtech::message::element<std::string_view>().parse(m_parser, m_offset);
+        }
+    };
+
+    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    request_parser() = default;
+
+    bool has_handle() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) handle() const
+    {
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
+    }
+
+    bool has_keys() const
+    {
+        return has_offset<1>();
+    }
+
+    decltype(auto) keys() const
+    {
+        return keys_parser(m_parser, offset<1>());
+    }
+
+    bool has_ushard() const
+    {
+        return has_offset<2>();
+    }
+
+    decltype(auto) ushard() const
+    {
+        return tyrtech::message::element<uint32_t>().parse(m_parser, offset<2>());
+    }
+};
+
+struct response_builder final : public tyrtech::message::struct_builder<2, 0>
+{
+    response_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_handle(const uint64_t& value)
+    {
+        set_offset<0>();
+        struct_builder<2, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t handle_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
+    }
+
+    decltype(auto) add_data()
+    {
+        set_offset<1>();
+        return m_builder;
+    }
+};
+
+struct response_parser final : public tyrtech::message::struct_parser<2, 0>
+{
+    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    response_parser() = default;
+
+    bool has_handle() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) handle() const
+    {
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
+    }
+
+    bool has_data() const
+    {
+        return has_offset<1>();
+    }
+
+    decltype(auto) data() const
+    {
+        return offset<1>();
+    }
+};
+
+}
+
+namespace messages::ingest_data {
+
+
+struct request_builder final : public tyrtech::message::struct_builder<2, 0>
+{
+    request_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_handle(const uint64_t& value)
+    {
+        set_offset<0>();
+        struct_builder<2, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t handle_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
+    }
+
+    decltype(auto) add_data()
+    {
+        set_offset<1>();
+        return m_builder;
+    }
+};
+
+struct request_parser final : public tyrtech::message::struct_parser<2, 0>
+{
+    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    request_parser() = default;
+
+    bool has_handle() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) handle() const
+    {
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
+    }
+
+    bool has_data() const
+    {
+        return has_offset<1>();
+    }
+
+    decltype(auto) data() const
+    {
+        return offset<1>();
+    }
+};
+
+struct response_builder final : public tyrtech::message::struct_builder<1, 0>
+{
+    response_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_handle(const uint64_t& value)
+    {
+        set_offset<0>();
+        struct_builder<1, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t handle_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
+    }
+};
+
+struct response_parser final : public tyrtech::message::struct_parser<1, 0>
+{
+    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    response_parser() = default;
+
+    bool has_handle() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) handle() const
+    {
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
+    }
+};
+
+}
+
+namespace messages::commit_ingest {
+
+
+struct request_builder final : public tyrtech::message::struct_builder<1, 0>
+{
+    request_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_handle(const uint64_t& value)
+    {
+        set_offset<0>();
+        struct_builder<1, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t handle_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
+    }
+};
+
+struct request_parser final : public tyrtech::message::struct_parser<1, 0>
+{
+    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    request_parser() = default;
+
+    bool has_handle() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) handle() const
+    {
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
+    }
+};
+
+struct response_builder final : public tyrtech::message::struct_builder<0, 0>
+{
+    response_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+};
+
+struct response_parser final : public tyrtech::message::struct_parser<0, 0>
+{
+    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    response_parser() = default;
+};
+
+}
+
+namespace messages::abort_ingest {
+
+
+struct request_builder final : public tyrtech::message::struct_builder<1, 0>
+{
+    request_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_handle(const uint64_t& value)
+    {
+        set_offset<0>();
+        struct_builder<1, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t handle_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
+    }
+};
+
+struct request_parser final : public tyrtech::message::struct_parser<1, 0>
+{
+    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    request_parser() = default;
+
+    bool has_handle() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) handle() const
+    {
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
+    }
+};
+
+struct response_builder final : public tyrtech::message::struct_builder<0, 0>
+{
+    response_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+};
+
+struct response_parser final : public tyrtech::message::struct_parser<0, 0>
+{
+    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    response_parser() = default;
+};
+
+}
+
+namespace messages::estimate_count {
+
+
+struct request_builder final : public tyrtech::message::struct_builder<3, 0>
+{
+    request_builder(tyrtech::message::builder* builder)
+      : struct_builder(builder)
+    {
+    }
+
+    void add_min_key(const std::string_view& value)
+    {
+        set_offset<0>();
+        struct_builder<3, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t min_key_bytes_required()
+    {
+        return tyrtech::message::element<std::string_view>::size;
+    }
+
+    void add_max_key(const std::string_view& value)
+    {
+        set_offset<1>();
+        struct_builder<3, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t max_key_bytes_required()
+    {
+        return tyrtech::message::element<std::string_view>::size;
+    }
+
+    void add_ushard(const uint32_t& value)
+    {
+        set_offset<2>();
+        struct_builder<3, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t ushard_bytes_required()
+    {
+        return tyrtech::message::element<uint32_t>::size;
+    }
+};
+
+struct request_parser final : public tyrtech::message::struct_parser<3, 0>
+{
+    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+      : struct_parser(parser, offset)
+    {
+    }
+
+    request_parser() = default;
+
+    bool has_min_key() const
+    {
+        return has_offset<0>();
+    }
+
+    decltype(auto) min_key() const
+    {
+        return tyrtech::message::element<std::string_view>().parse(m_parser, offset<0>());
+    }
+
+    bool has_max_key() const
+    {
+        return has_offset<1>();
+    }
+
+    decltype(auto) max_key() const
+    {
+        return tyrtech::message::element<std::string_view>().parse(m_parser, offset<1>());
+    }
+
+    bool has_ushard() const
+    {
+        return has_offset<2>();
+    }
+
+    decltype(auto) ushard() const
+    {
+        return tyrtech::message::element<uint32_t>().parse(m_parser, offset<2>());
+    }
+};
+
+struct response_builder final : public tyrtech::message::struct_builder<1, 0>
 {
-    request_builder(tyrtech::message::builder* builder)
+    response_builder(tyrtech::message::builder* builder)
       : struct_builder(builder)
     {
     }
 
-    void add_handle(const uint64_t& value)
+    void add_count(const uint64_t& value)
     {
         set_offset<0>();
         struct_builder<1, 0>::add_value(value);
     }
 
-    static constexpr uint16_t handle_bytes_required()
+    static constexpr uint16_t count_bytes_required()
     {
         return tyrtech::message::element<uint64_t>::size;
     }
 };
 
-struct request_parser final : public tyrtech::message::struct_parser<1, 0>
+struct response_parser final : public tyrtech::message::struct_parser<1, 0>
 {
-    request_parser(const tyrtech::message::parser* parser, uint16_t offset)
+    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
       : struct_parser(parser, offset)
     {
     }
 
-    request_parser() = default;
+    response_parser() = default;
 
-    bool has_handle() const
+    bool has_count() const
     {
         return has_offset<0>();
     }
 
-    decltype(auto) handle() const
+    decltype(auto) count() const
     {
         return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
     }
 };
 
-struct response_builder final : public tyrtech::message::struct_builder<0, 0>
-{
-    response_builder(tyrtech::message::builder* builder)
-      : struct_builder(builder)
-    {
-    }
-};
-
-struct response_parser final : public tyrtech::message::struct_parser<0, 0>
-{
-    response_parser(const tyrtech::message::parser* parser, uint16_t offset)
-      : struct_parser(parser, offset)
-    {
-    }
-
-    response_parser() = default;
-};
-
 }
 
-namespace messages::snapshot {
+namespace messages::count {
 
 
-struct request_builder final : public tyrtech::message::struct_builder<2, 0>
+struct request_builder final : public tyrtech::message::struct_builder<3, 0>
 {
     request_builder(tyrtech::message::builder* builder)
       : struct_builder(builder)
     {
     }
 
-    void add_collection(const std::string_view& value)
+    void add_min_key(const std::string_view& value)
     {
         set_offset<0>();
-        struct_builder<2, 0>::add_value(value);
+        struct_builder<3, 0>::add_value(value);
     }
 
-    static constexpr uint16_t collection_bytes_required()
+    static constexpr uint16_t min_key_bytes_required()
     {
         return tyrtech::message::element<std::string_view>::size;
     }
 
-    void add_ushard(const uint32_t& value)
+    void add_max_key(const std::string_view& value)
     {
         set_offset<1>();
-        struct_builder<2, 0>::add_value(value);
+        struct_builder<3, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t max_key_bytes_required()
+    {
+        return tyrtech::message::element<std::string_view>::size;
+    }
+
+    void add_ushard(const uint32_t& value)
+    {
+        set_offset<2>();
+        struct_builder<3, 0>::add_value(value);
     }
 
     static constexpr uint16_t ushard_bytes_required()
@@ -489,7 +1153,7 @@ struct request_builder final : public tyrtech::message::struct_builder<2, 0>
     }
 };
 
-struct request_parser final : public tyrtech::message::struct_parser<2, 0>
+struct request_parser final : public tyrtech::message::struct_parser<3, 0>
 {
     request_parser(const tyrtech::message::parser* parser, uint16_t offset)
       : struct_parser(parser, offset)
@@ -498,24 +1162,34 @@ struct request_parser final : public tyrtech::message::struct_parser<2, 0>
 
     request_parser() = default;
 
-    bool has_collection() const
+    bool has_min_key() const
     {
         return has_offset<0>();
     }
 
-    decltype(auto) collection() const
+    decltype(auto) min_key() const
     {
         return tyrtech::message::element<std::string_view>().parse(m_parser, offset<0>());
     }
 
-    bool has_ushard() const
+    bool has_max_key() const
     {
         return has_offset<1>();
     }
 
+    decltype(auto) max_key() const
+    {
+        return tyrtech::message::element<std::string_view>().parse(m_parser, offset<1>());
+    }
+
+    bool has_ushard() const
+    {
+        return has_offset<2>();
+    }
+
     decltype(auto) ushard() const
     {
-        return tyrtech::message::element<uint32_t>().parse(m_parser, offset<1>());
+        return tyrtech::message::element<uint32_t>().parse(m_parser, offset<2>());
     }
 };
 
@@ -526,10 +1200,15 @@ struct response_builder final : public tyrtech::message::struct_builder<1, 0>
     {
     }
 
-    decltype(auto) add_snapshot()
+    void add_count(const uint64_t& value)
     {
         set_offset<0>();
-        return m_builder;
+        struct_builder<1, 0>::add_value(value);
+    }
+
+    static constexpr uint16_t count_bytes_required()
+    {
+        return tyrtech::message::element<uint64_t>::size;
     }
 };
 
@@ -542,14 +1221,14 @@ struct response_parser final : public tyrtech::message::struct_parser<1, 0>
 
     response_parser() = default;
 
-    bool has_snapshot() const
+    bool has_count() const
     {
         return has_offset<0>();
     }
 
-    decltype(auto) snapshot() const
+    decltype(auto) count() const
     {
-        return offset<0>();
+        return tyrtech::message::element<uint64_t>().parse(m_parser, offset<0>());
     }
 };
 
@@ -714,6 +1393,144 @@ struct snapshot
     }
 };
 
+struct multi_get
+{
+    static constexpr uint16_t id{7};
+    static constexpr uint16_t module_id{1};
+
+    using request_builder_t =
+            messages::multi_get::request_builder;
+
+    using request_parser_t =
+            messages::multi_get::request_parser;
+
+    using response_builder_t =
+            messages::multi_get::response_builder;
+
+    using response_parser_t =
+            messages::multi_get::response_parser;
+
+    static void throw_exception(const tyrtech::net::service::error_parser& error)
+    {
+        throw_module_exception(error);
+    }
+};
+
+struct ingest_data
+{
+    static constexpr uint16_t id{8};
+    static constexpr uint16_t module_id{1};
+
+    using request_builder_t =
+            messages::ingest_data::request_builder;
+
+    using request_parser_t =
+            messages::ingest_data::request_parser;
+
+    using response_builder_t =
+            messages::ingest_data::response_builder;
+
+    using response_parser_t =
+            messages::ingest_data::response_parser;
+
+    static void throw_exception(const tyrtech::net::service::error_parser& error)
+    {
+        throw_module_exception(error);
+    }
+};
+
+struct commit_ingest
+{
+    static constexpr uint16_t id{9};
+    static constexpr uint16_t module_id{1};
+
+    using request_builder_t =
+            messages::commit_ingest::request_builder;
+
+    using request_parser_t =
+            messages::commit_ingest::request_parser;
+
+    using response_builder_t =
+            messages::commit_ingest::response_builder;
+
+    using response_parser_t =
+            messages::commit_ingest::response_parser;
+
+    static void throw_exception(const tyrtech::net::service::error_parser& error)
+    {
+        throw_module_exception(error);
+    }
+};
+
+struct abort_ingest
+{
+    static constexpr uint16_t id{10};
+    static constexpr uint16_t module_id{1};
+
+    using request_builder_t =
+            messages::abort_ingest::request_builder;
+
+    using request_parser_t =
+            messages::abort_ingest::request_parser;
+
+    using response_builder_t =
+            messages::abort_ingest::response_builder;
+
+    using response_parser_t =
+            messages::abort_ingest::response_parser;
+
+    static void throw_exception(const tyrtech::net::service::error_parser& error)
+    {
+        throw_module_exception(error);
+    }
+};
+
+struct estimate_count
+{
+    static constexpr uint16_t id{11};
+    static constexpr uint16_t module_id{1};
+
+    using request_builder_t =
+            messages::estimate_count::request_builder;
+
+    using request_parser_t =
+            messages::estimate_count::request_parser;
+
+    using response_builder_t =
+            messages::estimate_count::response_builder;
+
+    using response_parser_t =
+            messages::estimate_count::response_parser;
+
+    static void throw_exception(const tyrtech::net::service::error_parser& error)
+    {
+        throw_module_exception(error);
+    }
+};
+
+struct count
+{
+    static constexpr uint16_t id{12};
+    static constexpr uint16_t module_id{1};
+
+    using request_builder_t =
+            messages::count::request_builder;
+
+    using request_parser_t =
+            messages::count::request_parser;
+
+    using response_builder_t =
+            messages::count::response_builder;
+
+    using response_parser_t =
+            messages::count::response_parser;
+
+    static void throw_exception(const tyrtech::net::service::error_parser& error)
+    {
+        throw_module_exception(error);
+    }
+};
+
 template<typename Implementation>
 struct module : private tyrtech::disallow_copy
 {
@@ -826,6 +1643,102 @@ struct module : private tyrtech::disallow_copy
 
                 break;
             }
+            case multi_get::id:
+            {
+                using request_parser_t =
+                        typename multi_get::request_parser_t;
+
+                using response_builder_t =
+                        typename multi_get::response_builder_t;
+
+                request_parser_t request(service_request.get_parser(),
+                                         service_request.message());
+                response_builder_t response(service_response->add_message());
+
+                impl->multi_get(request, &response, ctx);
+
+                break;
+            }
+            case ingest_data::id:
+            {
+                using request_parser_t =
+                        typename ingest_data::request_parser_t;
+
+                using response_builder_t =
+                        typename ingest_data::response_builder_t;
+
+                request_parser_t request(service_request.get_parser(),
+                                         service_request.message());
+                response_builder_t response(service_response->add_message());
+
+                impl->ingest_data(request, &response, ctx);
+
+                break;
+            }
+            case commit_ingest::id:
+            {
+                using request_parser_t =
+                        typename commit_ingest::request_parser_t;
+
+                using response_builder_t =
+                        typename commit_ingest::response_builder_t;
+
+                request_parser_t request(service_request.get_parser(),
+                                         service_request.message());
+                response_builder_t response(service_response->add_message());
+
+                impl->commit_ingest(request, &response, ctx);
+
+                break;
+            }
+            case abort_ingest::id:
+            {
+                using request_parser_t =
+                        typename abort_ingest::request_parser_t;
+
+                using response_builder_t =
+                        typename abort_ingest::response_builder_t;
+
+                request_parser_t request(service_request.get_parser(),
+                                         service_request.message());
+                response_builder_t response(service_response->add_message());
+
+                impl->abort_ingest(request, &response, ctx);
+
+                break;
+            }
+            case estimate_count::id:
+            {
+                using request_parser_t =
+                        typename estimate_count::request_parser_t;
+
+                using response_builder_t =
+                        typename estimate_count::response_builder_t;
+
+                request_parser_t request(service_request.get_parser(),
+                                         service_request.message());
+                response_builder_t response(service_response->add_message());
+
+                impl->estimate_count(request, &response, ctx);
+
+                break;
+            }
+            case count::id:
+            {
+                using request_parser_t =
+                        typename count::request_parser_t;
+
+                using response_builder_t =
+                        typename count::response_builder_t;
+
+                request_parser_t request(service_request.get_parser(),
+                                         service_request.message());
+                response_builder_t response(service_response->add_message());
+
+                impl->count(request, &response, ctx);
+
+                break;
+            }
             default:
             {
                 throw tyrtech::net::unknown_function_error("#{}: unknown function", service_request.function());
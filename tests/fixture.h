@@ -0,0 +1,99 @@
+#pragma once
+
+
+#include <common/uuid.h>
+#include <common/cpu_sched.h>
+#include <gt/async.h>
+#include <io/engine.h>
+#include <storage/engine.h>
+#include <tyrdbs/ushard.h>
+#include <tyrdbs/cache.h>
+
+#include <crc32c.h>
+
+#include <cstdint>
+#include <cassert>
+#include <set>
+
+
+namespace tests {
+
+
+struct meta_callback : public tyrtech::tyrdbs::ushard::meta_callback
+{
+    void add(uint32_t level, const tyrtech::tyrdbs::ushard::slices_t& slices) override
+    {
+        last_level = level;
+    }
+
+    void remove(const tyrtech::tyrdbs::ushard::slices_t& slices) override
+    {
+        removed += slices.size();
+
+        for (auto&& slice : slices)
+        {
+            slice->unlink();
+        }
+    }
+
+    void add_segment(const tyrtech::tyrdbs::value_log::segment_ptr& segment) override
+    {
+        added_segments++;
+    }
+
+    void remove_segments(const tyrtech::tyrdbs::value_log::segments_t& segments) override
+    {
+        removed_segments += segments.size();
+    }
+
+    void merge(uint16_t tier) override
+    {
+        levels.insert(tier);
+        merges++;
+    }
+
+    void flush() override
+    {
+    }
+
+    std::set<uint32_t> levels;
+
+    uint32_t last_level{0};
+    uint32_t merges{0};
+    uint32_t removed{0};
+    uint32_t added_segments{0};
+    uint32_t removed_segments{0};
+};
+
+
+inline void run_test(void (*test)())
+{
+    using namespace tyrtech;
+
+    storage::initialize(io::file::create("_test/{}", uuid()), 18, 14, false);
+
+    test();
+}
+
+inline int run(void (*test)())
+{
+    using namespace tyrtech;
+
+    set_cpu(0);
+
+    assert(crc32c_initialize() == true);
+
+    gt::initialize();
+    gt::async::initialize();
+    io::initialize(4096);
+    io::file::initialize(32);
+
+    tyrdbs::cache::initialize(12);
+
+    gt::create_thread(run_test, test);
+    gt::run();
+
+    return 0;
+}
+
+}
@@ -0,0 +1,285 @@
+#include <common/cmd_line.h>
+#include <common/cpu_sched.h>
+#include <common/clock.h>
+#include <common/logger.h>
+#include <common/buffered_writer.h>
+#include <common/buffered_reader.h>
+#include <tyrdbs/gorilla_writer.h>
+#include <tyrdbs/gorilla_reader.h>
+#include <tyrdbs/gorilla_decoder.h>
+
+#include <random>
+#include <vector>
+#include <cstring>
+
+
+using namespace tyrtech;
+
+
+struct chunk
+{
+    uint32_t samples{0};
+
+    std::vector<uint64_t> timestamps;
+    std::vector<uint64_t> values;
+
+    std::string data;
+};
+
+
+using chunks_t =
+        std::vector<chunk>;
+
+
+chunk generate(std::mt19937_64* rnd, uint32_t samples)
+{
+    using writer_t =
+            buffered_writer<std::string>;
+
+    chunk c;
+
+    c.samples = samples;
+
+    uint64_t timestamp = 1600000000 + (*rnd)() % 86400;
+    double value = ((*rnd)() % 10000) / 100.;
+
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        timestamp += 60;
+
+        switch ((*rnd)() % 8)
+        {
+            case 0:
+                timestamp += (*rnd)() % 5;
+                break;
+            case 1:
+                timestamp += (*rnd)() % 300;
+                break;
+            default:
+                break;
+        }
+
+        switch ((*rnd)() % 4)
+        {
+            case 0:
+                value += ((*rnd)() % 200) / 100. - 1;
+                break;
+            case 1:
+                value = static_cast<uint32_t>(value) + ((*rnd)() % 10);
+                break;
+            default:
+                break;
+        }
+
+        uint64_t v = 0;
+        std::memcpy(&v, &value, sizeof(v));
+
+        c.timestamps.push_back(timestamp);
+        c.values.push_back(v);
+    }
+
+    c.data.resize((samples + 1) * 16);
+
+    writer_t writer(&c.data);
+    tyrdbs::gorilla_writer<writer_t> encoder(&writer);
+
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        encoder.write(c.timestamps[i], c.values[i]);
+    }
+
+    encoder.flush();
+
+    c.data.resize(writer.offset());
+
+    return c;
+}
+
+
+uint64_t read(const chunks_t& chunks)
+{
+    using reader_t =
+            buffered_reader<const std::string_view>;
+
+    uint64_t checksum = 0;
+
+    for (auto&& c : chunks)
+    {
+        std::string_view data(c.data);
+
+        reader_t reader(&data);
+        tyrdbs::gorilla_reader<reader_t> decoder(c.samples, &reader);
+
+        uint32_t ndx = 0;
+
+        while (decoder.next() == true)
+        {
+            auto&& v = decoder.value();
+
+            assert(v.timestamp == c.timestamps[ndx]);
+            assert(v.value == c.values[ndx]);
+
+            checksum += v.timestamp ^ v.value;
+            ndx++;
+        }
+
+        assert(ndx == c.samples);
+    }
+
+    return checksum;
+}
+
+
+uint64_t decode(const chunks_t& chunks, uint32_t batch_size)
+{
+    std::vector<uint64_t> timestamps(batch_size);
+    std::vector<uint64_t> values(batch_size);
+
+    uint64_t checksum = 0;
+
+    for (auto&& c : chunks)
+    {
+        tyrdbs::gorilla_decoder decoder(c.samples, c.data.data(), c.data.size());
+
+        uint32_t ndx = 0;
+
+        while (true)
+        {
+            uint32_t count = decoder.decode(timestamps.data(), values.data(), batch_size);
+
+            if (count == 0)
+            {
+                break;
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                assert(timestamps[i] == c.timestamps[ndx]);
+                assert(values[i] == c.values[ndx]);
+
+                checksum += timestamps[i] ^ values[i];
+                ndx++;
+            }
+        }
+
+        assert(ndx == c.samples);
+    }
+
+    return checksum;
+}
+
+
+template<typename Function>
+uint64_t measure(const char* name,
+                 uint64_t samples,
+                 uint32_t iterations,
+                 Function&& function)
+{
+    uint64_t checksum = 0;
+
+    auto t1 = clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        checksum = function();
+    }
+
+    auto t2 = clock::now();
+
+    uint64_t duration = t2 - t1;
+
+    logger::notice("{}: decoded {} samples in {:.6f} s, {:.2f} samples/s",
+                   name,
+                   samples * iterations,
+                   duration / 1000000000.,
+                   samples * iterations * 1000000000. / duration);
+
+    return checksum;
+}
+
+
+int main(int argc, const char* argv[])
+{
+    cmd_line cmd(argv[0], "Gorilla decoder benchmark.", nullptr);
+
+    cmd.add_param("cpu",
+                  nullptr,
+                  "cpu",
+                  "index",
+                  "0",
+                  {"cpu index to run the program on (default is 0)"});
+
+    cmd.add_param("chunks",
+                  nullptr,
+                  "chunks",
+                  "num",
+                  "4096",
+                  {"number of chunks to decode (default is 4096)"});
+
+    cmd.add_param("samples",
+                  nullptr,
+                  "samples",
+                  "num",
+                  "120",
+                  {"number of samples per chunk (default is 120)"});
+
+    cmd.add_param("batch-size",
+                  nullptr,
+                  "batch-size",
+                  "num",
+                  "256",
+                  {"number of samples decoded per batch (default is 256)"});
+
+    cmd.add_param("iterations",
+                  nullptr,
+                  "iterations",
+                  "num",
+                  "32",
+                  {"number of iterations to do (default is 32)"});
+
+    cmd.parse(argc, argv);
+
+    set_cpu(cmd.get<uint32_t>("cpu"));
+
+    uint32_t samples = cmd.get<uint32_t>("samples");
+    uint32_t iterations = cmd.get<uint32_t>("iterations");
+    uint32_t batch_size = cmd.get<uint32_t>("batch-size");
+
+    assert(batch_size != 0);
+
+    std::mt19937_64 rnd(samples);
+    chunks_t chunks;
+
+    uint64_t size = 0;
+
+    for (uint32_t i = 0; i < cmd.get<uint32_t>("chunks"); i++)
+    {
+        chunks.push_back(generate(&rnd, samples));
+        size += chunks.back().data.size();
+    }
+
+    uint64_t total = static_cast<uint64_t>(samples) * chunks.size();
+
+    logger::notice("encoded {} samples into {} bytes, {:.2f} bytes/sample",
+                   total,
+                   size,
+                   static_cast<double>(size) / total);
+
+    uint64_t c1 = measure("gorilla_reader", total, iterations, [&chunks]
+    {
+        return read(chunks);
+    });
+
+    uint64_t c2 = measure("gorilla_decoder", total, iterations, [&chunks, batch_size]
+    {
+        return decode(chunks, batch_size);
+    });
+
+    if (c1 != c2)
+    {
+        logger::error("checksum mismatch: {:016x} != {:016x}", c1, c2);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+#include <map>
+#include <set>
+
+
+using namespace tyrtech;
+
+
+using entries_t =
+        std::map<std::string, std::string>;
+
+
+void read(tyrdbs::iterator* it, entries_t* entries)
+{
+    std::string key;
+    std::string value;
+
+    while (it->next() == true)
+    {
+        if (key.compare(it->key()) != 0)
+        {
+            assert(value.size() == 0);
+            key.assign(it->key());
+        }
+
+        value.append(it->value());
+
+        if (it->eor() == true)
+        {
+            if (it->deleted() == false)
+            {
+                (*entries)[key] = std::move(value);
+            }
+
+            value.clear();
+        }
+    }
+
+    assert(value.size() == 0);
+}
+
+
+void verify(tyrdbs::ushard* ushard, const entries_t& expected)
+{
+    entries_t entries;
+    read(ushard->begin().get(), &entries);
+
+    assert(entries == expected);
+
+    entries.clear();
+
+    for (auto&& it : expected)
+    {
+        read(ushard->get(it.first).get(), &entries);
+    }
+
+    assert(entries == expected);
+}
+
+
+void merge(tyrdbs::ushard* ushard, tests::meta_callback* cb)
+{
+    while (cb->levels.size() != 0)
+    {
+        uint32_t level = *cb->levels.begin();
+        cb->levels.erase(cb->levels.begin());
+
+        ushard->merge(level, cb);
+    }
+}
+
+
+std::string value_of(uint64_t idx, uint32_t ndx)
+{
+    return fmt::format("value{}-{}", idx, std::string(ndx % 128, 'v'));
+}
+
+
+void test_policy(tyrdbs::compaction_policy::type policy, uint32_t value_threshold)
+{
+    auto c = std::make_shared<tyrdbs::collection>("test", policy);
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+    ushard->set_value_threshold(value_threshold);
+
+    entries_t expected;
+    uint64_t idx = 1;
+
+    for (uint32_t batch = 0; batch < 8; batch++)
+    {
+        for (uint32_t ndx = batch; ndx < 8000; ndx += 8)
+        {
+            auto key = fmt::format("key{:06}", ndx);
+            auto value = value_of(idx, ndx);
+
+            ushard->write(key, value, true, false, idx, 0);
+            expected[key] = value;
+        }
+
+        idx++;
+
+        ushard->seal(true, &cb);
+        ushard->flush(&cb);
+
+        merge(ushard.get(), &cb);
+    }
+
+    verify(ushard.get(), expected);
+
+    auto&& ingester = ushard->ingest();
+
+    for (uint32_t ndx = 8000; ndx < 24000; ndx++)
+    {
+        auto key = fmt::format("key{:06}", ndx);
+        auto value = value_of(idx, ndx);
+
+        ingester->add(key, value, true, false, idx, 0);
+        expected[key] = value;
+    }
+
+    idx++;
+
+    uint32_t slice_count = ushard->get_slices().size();
+    uint32_t removed = cb.removed;
+
+    assert(ingester->commit(&cb) == 16000);
+    assert(ushard->get_slices().size() == slice_count + 1);
+    assert(cb.removed == removed);
+
+    if (policy == tyrdbs::compaction_policy::type::leveled)
+    {
+        assert(cb.last_level != 0);
+    }
+
+    if (value_threshold != 0)
+    {
+        assert(cb.added_segments == 9);
+    }
+
+    verify(ushard.get(), expected);
+
+    ingester = ushard->ingest();
+
+    for (uint32_t ndx = 0; ndx < 24000; ndx += 3)
+    {
+        auto key = fmt::format("key{:06}", ndx);
+
+        if (ndx % 2 == 0)
+        {
+            ingester->add(key, std::string_view(), true, true, idx, 0);
+            expected.erase(key);
+        }
+        else
+        {
+            auto value = value_of(idx, ndx);
+
+            ingester->add(key, value, true, false, idx, 0);
+            expected[key] = value;
+        }
+    }
+
+    idx++;
+
+    assert(ingester->commit(&cb) == 8000);
+
+    if (policy == tyrdbs::compaction_policy::type::leveled)
+    {
+        assert(cb.last_level == 0);
+    }
+
+    merge(ushard.get(), &cb);
+
+    verify(ushard.get(), expected);
+
+    auto&& slices = ushard->get_slices();
+
+    ingester = ushard->ingest();
+    ingester->add("key000002", "value", true, false, idx, 0);
+
+    bool thrown = false;
+
+    try
+    {
+        ingester->add("key000001", "value", true, false, idx, 0);
+    }
+    catch (tyrdbs::slice_writer::invalid_data_error&)
+    {
+        thrown = true;
+    }
+
+    assert(thrown == true);
+
+    ingester.reset();
+
+    assert(ushard->get_slices() == slices);
+
+    verify(ushard.get(), expected);
+
+    ushard->compact(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+
+    verify(ushard.get(), expected);
+}
+
+
+void test()
+{
+    test_policy(tyrdbs::compaction_policy::type::tiered, 0);
+    test_policy(tyrdbs::compaction_policy::type::leveled, 0);
+    test_policy(tyrdbs::compaction_policy::type::tiered, 64);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -0,0 +1,118 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+
+using namespace tyrtech;
+
+
+struct counter_operator : public tyrdbs::ushard::merge_operator
+{
+    void merge(const std::string_view& key,
+               const std::string_view& older_value,
+               std::string* value) const override
+    {
+        if (value->front() == '=')
+        {
+            return;
+        }
+
+        auto sum = std::stol(std::string(older_value.substr(older_value.front() == '=')));
+        sum += std::stol(*value);
+
+        *value = std::to_string(sum);
+
+        if (older_value.front() == '=')
+        {
+            value->insert(0, 1, '=');
+        }
+    }
+
+    void truncate(const std::string_view& key, std::string* value) const override
+    {
+        if (value->front() != '=')
+        {
+            value->insert(0, 1, '=');
+        }
+    }
+};
+
+
+int64_t get(tyrdbs::ushard* ushard, const std::string_view& key)
+{
+    auto&& it = ushard->get(key);
+
+    assert(it->next() == true);
+    assert(it->key().compare(key) == 0);
+    assert(it->deleted() == false);
+
+    auto value = it->value();
+
+    return std::stol(std::string(value.substr(value.front() == '=')));
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test",
+                                                  tyrdbs::compaction_policy::type::tiered,
+                                                  std::make_shared<counter_operator>());
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    uint64_t idx = 1;
+
+    for (uint32_t round = 0; round < 8; round++)
+    {
+        for (uint32_t ndx = 0; ndx < 100; ndx++)
+        {
+            auto key = fmt::format("key{:04}", ndx);
+            ushard->write(key, "1", true, false, idx++, 0);
+        }
+
+        if (round == 3)
+        {
+            ushard->write("key0007", "", true, true, idx++, 0);
+        }
+
+        ushard->seal(true, &cb);
+        ushard->flush(&cb);
+    }
+
+    ushard->write("key0000", "10", true, false, idx++, 0);
+
+    assert(get(ushard.get(), "key0000") == 18);
+    assert(get(ushard.get(), "key0007") == 4);
+    assert(get(ushard.get(), "key0099") == 8);
+
+    ushard->seal(true, &cb);
+    ushard->flush(&cb);
+
+    ushard->compact(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+
+    assert(get(ushard.get(), "key0000") == 18);
+    assert(get(ushard.get(), "key0007") == 4);
+    assert(get(ushard.get(), "key0099") == 8);
+
+    ushard->write("key0050", "", true, true, idx++, 0);
+
+    auto&& it = ushard->range("key0049", "key0051");
+
+    assert(it->next() == true && it->key().compare("key0049") == 0);
+    assert(it->next() == true && it->key().compare("key0050") == 0 && it->deleted() == true);
+    assert(it->next() == true && it->key().compare("key0051") == 0);
+    assert(it->next() == false);
+
+    ushard->write("key0050", "3", true, false, idx++, 0);
+
+    assert(get(ushard.get(), "key0050") == 3);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -0,0 +1,125 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+#include <random>
+#include <map>
+#include <set>
+
+
+using namespace tyrtech;
+
+
+using entry_t =
+        std::pair<std::string, bool>;
+
+using entries_t =
+        std::map<std::string, entry_t>;
+
+
+void read(tyrdbs::iterator* it, entries_t* entries)
+{
+    std::string key;
+    std::string value;
+
+    while (it->next() == true)
+    {
+        if (key.compare(it->key()) != 0)
+        {
+            assert(value.size() == 0);
+
+            key.assign(it->key());
+            assert(entries->find(key) == entries->end());
+        }
+
+        value.append(it->value());
+
+        if (it->eor() == true)
+        {
+            (*entries)[key] = entry_t(std::move(value), it->deleted());
+            value.clear();
+        }
+    }
+
+    assert(value.size() == 0);
+}
+
+
+void verify(tyrdbs::ushard* ushard, std::mt19937* rnd)
+{
+    std::vector<std::string> keys;
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        keys.push_back(fmt::format("key{:06}", (*rnd)() % 22000));
+    }
+
+    keys.push_back("a");
+    keys.push_back("zzz");
+
+    entries_t expected;
+
+    for (auto&& key : std::set<std::string>(keys.begin(), keys.end()))
+    {
+        read(ushard->get(key).get(), &expected);
+    }
+
+    entries_t entries;
+
+    tyrdbs::slice::key_views_t key_views(keys.begin(), keys.end());
+    read(ushard->multi_get(std::move(key_views)).get(), &entries);
+
+    assert(expected.size() > 100);
+
+    assert(entries == expected);
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test");
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    std::mt19937 rnd(0);
+
+    uint64_t idx = 1;
+
+    for (uint32_t round = 0; round < 5; round++)
+    {
+        for (uint32_t ndx = round; ndx < 20000; ndx += 1 + rnd() % 4)
+        {
+            auto key = fmt::format("key{:06}", ndx);
+
+            if (rnd() % 16 == 0)
+            {
+                ushard->write(key, std::string_view(), true, true, idx++, 0);
+                continue;
+            }
+
+            std::string value(rnd() % 64 == 0 ? 20000 : 16, 'a' + round);
+            ushard->write(key, value, true, false, idx++, 0);
+        }
+
+        if (round != 4)
+        {
+            ushard->seal(true, &cb);
+            ushard->flush(&cb);
+        }
+
+        verify(ushard.get(), &rnd);
+    }
+
+    assert(ushard->get_slices().size() == 4);
+
+    ushard->compact(&cb);
+
+    verify(ushard.get(), &rnd);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -0,0 +1,288 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+#include <random>
+#include <map>
+
+
+using namespace tyrtech;
+
+
+struct concat_operator : public tyrdbs::ushard::merge_operator
+{
+    void merge(const std::string_view& key,
+               const std::string_view& older_value,
+               std::string* value) const override
+    {
+        value->insert(0, older_value);
+    }
+
+    void truncate(const std::string_view& key, std::string* value) const override
+    {
+    }
+};
+
+
+using record_t =
+        std::pair<std::string, bool>;
+
+using records_t =
+        std::map<std::string, record_t>;
+
+
+static constexpr uint32_t max_keys{50000};
+
+
+std::string key_of(int32_t ndx)
+{
+    return fmt::format("key{:06}", std::max(ndx, 0));
+}
+
+
+void read_record(tyrdbs::iterator* it, std::string* key, record_t* record)
+{
+    key->assign(it->key());
+
+    record->first.assign(it->value());
+    record->second = it->deleted();
+
+    while (it->eor() == false)
+    {
+        bool has_next = it->next();
+        assert(has_next == true);
+
+        assert(it->key() == *key);
+        record->first.append(it->value());
+    }
+}
+
+
+void check(std::unique_ptr<tyrdbs::iterator> it,
+           const records_t& expected,
+           uint32_t step,
+           std::mt19937* rnd)
+{
+    std::string cursor;
+    int32_t cursor_ndx = 0;
+
+    uint32_t seeks = 0;
+
+    while (true)
+    {
+        bool has_next = false;
+        records_t::const_iterator e;
+
+        if ((*rnd)() % 4 == 0)
+        {
+            has_next = it->next();
+            e = expected.upper_bound(cursor);
+        }
+        else
+        {
+            auto target = key_of(cursor_ndx + (*rnd)() % step - step / 8);
+
+            has_next = it->seek(target);
+            e = expected.lower_bound(std::max(target, cursor));
+
+            if (e != expected.end() && e->first == cursor)
+            {
+                e++;
+            }
+
+            seeks++;
+        }
+
+        if (e == expected.end())
+        {
+            assert(has_next == false);
+            break;
+        }
+
+        assert(has_next == true);
+
+        std::string key;
+        record_t record;
+
+        read_record(it.get(), &key, &record);
+
+        assert(key == e->first);
+        assert(record == e->second);
+
+        cursor = key;
+        cursor_ndx = std::stoi(key.substr(3));
+    }
+
+    assert(it->next() == false);
+    assert(it->seek(key_of(0)) == false);
+
+    assert(seeks != 0);
+}
+
+
+records_t subrange(const records_t& records,
+                   const std::string& min_key,
+                   const std::string& max_key)
+{
+    return records_t(records.lower_bound(min_key), records.upper_bound(max_key));
+}
+
+
+records_t live(const records_t& records)
+{
+    records_t live_records;
+
+    for (auto&& it : records)
+    {
+        if (it.second.second == false)
+        {
+            live_records.insert(it);
+        }
+    }
+
+    return live_records;
+}
+
+
+void write(tyrdbs::ushard* ushard,
+           const std::string& key,
+           const std::string& value,
+           uint64_t idx)
+{
+    std::string_view data(value);
+
+    while (data.size() > 3000)
+    {
+        ushard->write(key, data.substr(0, 3000), false, false, idx, 0);
+        data.remove_prefix(3000);
+    }
+
+    ushard->write(key, data, true, false, idx, 0);
+}
+
+
+void test_ushard(bool fold, uint32_t value_threshold)
+{
+    auto c = std::make_shared<tyrdbs::collection>("test");
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    if (fold == true)
+    {
+        ushard->set_merge_operator(std::make_shared<concat_operator>());
+    }
+
+    ushard->set_value_threshold(value_threshold);
+
+    std::mt19937 rnd(fold);
+
+    records_t records;
+    uint64_t idx = 1;
+
+    for (uint32_t round = 0; round < 4; round++)
+    {
+        for (uint32_t ndx = round; ndx < max_keys; ndx += 1 + rnd() % 5)
+        {
+            auto key = key_of(ndx);
+
+            if (fold == false && rnd() % 16 == 0)
+            {
+                ushard->write(key, std::string_view(), true, true, idx, 0);
+                records[key] = record_t(std::string(), true);
+
+                continue;
+            }
+
+            uint32_t size = rnd() % 64 == 0 ? 1000 + rnd() % 20000 : rnd() % 32;
+            std::string value(size, 'a' + round);
+
+            write(ushard.get(), key, value, idx);
+
+            auto& record = records[key];
+
+            if (fold == true)
+            {
+                record.first.append(value);
+            }
+            else
+            {
+                record = record_t(std::move(value), false);
+            }
+        }
+
+        idx++;
+
+        if (round != 3)
+        {
+            ushard->seal(true, &cb);
+            ushard->flush(&cb);
+        }
+    }
+
+    for (uint32_t step : {4, 64, 4096})
+    {
+        check(ushard->begin(), records, step, &rnd);
+
+        auto min_key = key_of(rnd() % max_keys);
+        auto max_key = key_of(rnd() % max_keys);
+
+        if (min_key > max_key)
+        {
+            std::swap(min_key, max_key);
+        }
+
+        check(ushard->range(min_key, max_key), subrange(records, min_key, max_key), step, &rnd);
+
+        tyrdbs::slice::key_views_t keys;
+        records_t point_records;
+
+        for (auto&& it : records)
+        {
+            if (rnd() % 8 == 0)
+            {
+                keys.push_back(it.first);
+                point_records.insert(it);
+            }
+        }
+
+        check(ushard->multi_get(std::move(keys)), point_records, step, &rnd);
+    }
+
+    ushard->seal(true, &cb);
+    ushard->flush(&cb);
+    ushard->compact(&cb);
+
+    if (fold == false)
+    {
+        records = live(records);
+    }
+
+    check(ushard->begin(), records, 64, &rnd);
+
+    if (value_threshold != 0)
+    {
+        return;
+    }
+
+    assert(ushard->get_slices().size() == 1);
+
+    for (uint32_t step : {4, 64, 4096})
+    {
+        check(ushard->get_slices()[0]->begin(), records, step, &rnd);
+    }
+}
+
+
+void test()
+{
+    test_ushard(false, 0);
+    test_ushard(false, 1024);
+    test_ushard(true, 0);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -0,0 +1,120 @@
+#include <tyrdbs/collection.h>
+#include <tyrdbs/series_writer.h>
+#include <tyrdbs/series_reader.h>
+#include <tests/fixture.h>
+
+#include <map>
+
+
+using namespace tyrtech;
+
+
+using expected_t =
+        std::map<std::pair<std::string, uint64_t>, uint64_t>;
+
+
+static constexpr uint64_t bucket_size{3600};
+
+
+void verify(tyrdbs::ushard* ushard,
+            const expected_t& expected,
+            const std::string& series,
+            uint64_t min_timestamp,
+            uint64_t max_timestamp)
+{
+    tyrdbs::series_reader reader(ushard, series, min_timestamp, max_timestamp, bucket_size);
+
+    auto it = expected.lower_bound(std::make_pair(series, min_timestamp));
+    auto end = expected.upper_bound(std::make_pair(series, max_timestamp));
+
+    while (reader.next() == true)
+    {
+        assert(it != end);
+
+        assert(it->first.second == reader.timestamp());
+        assert(it->second == reader.value());
+
+        ++it;
+    }
+
+    assert(it == end);
+}
+
+
+void verify(tyrdbs::ushard* ushard, const expected_t& expected)
+{
+    for (auto&& series : {"cpu", "cpu1", "mem"})
+    {
+        verify(ushard, expected, series, 0, static_cast<uint64_t>(-1));
+        verify(ushard, expected, series, 1000000, 1000000);
+        verify(ushard, expected, series, 1001234, 1012345);
+        verify(ushard, expected, series, 1007200, 1010799);
+    }
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test",
+                                                  tyrdbs::compaction_policy::type::tiered,
+                                                  std::make_shared<tyrdbs::chunk_merge_operator>());
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    expected_t expected;
+
+    tyrdbs::series_writer writer(bucket_size);
+
+    uint64_t idx = 1;
+
+    for (uint32_t round = 0; round < 6; round++)
+    {
+        for (uint64_t timestamp = 1000000 + round; timestamp < 1020000; timestamp += 60)
+        {
+            for (auto&& series : {"cpu", "cpu1", "mem"})
+            {
+                uint64_t value = 0x4059000000000000UL + (timestamp % 7) * round;
+
+                writer.add(series, timestamp, value);
+                expected[std::make_pair(series, timestamp)] = value;
+            }
+        }
+
+        writer.add("cpu", 1000000, round);
+        expected[std::make_pair("cpu", 1000000)] = round;
+
+        writer.flush(ushard.get(), idx++, 0);
+
+        if (round % 2 == 1)
+        {
+            ushard->seal(true, &cb);
+            ushard->flush(&cb);
+        }
+
+        verify(ushard.get(), expected);
+    }
+
+    ushard->compact(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+
+    verify(ushard.get(), expected);
+
+    auto&& it = ushard->begin();
+    uint64_t size = 0;
+
+    while (it->next() == true)
+    {
+        size += it->value().size();
+    }
+
+    assert(size * 4 < expected.size() * sizeof(tyrdbs::chunk::point));
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -0,0 +1,125 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+#include <random>
+#include <map>
+
+
+using namespace tyrtech;
+
+
+using entries_t =
+        std::map<std::string, std::string>;
+
+
+void read(tyrdbs::iterator* it, entries_t* entries)
+{
+    std::string key;
+    std::string value;
+
+    while (it->next() == true)
+    {
+        if (key.compare(it->key()) != 0)
+        {
+            assert(value.size() == 0);
+            key.assign(it->key());
+        }
+
+        value.append(it->value());
+
+        if (it->eor() == true)
+        {
+            (*entries)[key] = std::move(value);
+            value.clear();
+        }
+    }
+
+    assert(value.size() == 0);
+}
+
+
+void verify(tyrdbs::ushard* ushard, const entries_t& expected)
+{
+    entries_t entries;
+    read(ushard->begin().get(), &entries);
+
+    assert(entries == expected);
+
+    for (auto it = expected.begin(); it != expected.end(); it++)
+    {
+        entries.clear();
+        read(ushard->get(it->first).get(), &entries);
+
+        assert(entries.size() == 1);
+        assert(entries.begin()->second == it->second);
+
+        entries.clear();
+        read(ushard->range(it->first, it->first).get(), &entries);
+
+        assert(entries.size() == 1);
+        assert(entries.begin()->second == it->second);
+
+        auto next = std::next(it);
+
+        if (next == expected.end())
+        {
+            continue;
+        }
+
+        entries.clear();
+        read(ushard->range(it->first, next->first).get(), &entries);
+
+        assert(entries.size() == 2);
+        assert(entries.begin()->second == it->second);
+        assert(entries.rbegin()->second == next->second);
+    }
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test");
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    std::mt19937 rnd(0);
+
+    entries_t expected;
+
+    for (uint32_t ndx = 0; ndx < 2000; ndx++)
+    {
+        auto key = fmt::format("key{:06}", ndx);
+        auto value = fmt::format("{}-{}", ndx, std::string(100 + rnd() % 5000, 'a' + ndx % 26));
+
+        std::string_view data(value);
+
+        while (data.size() > 3000)
+        {
+            ushard->write(key, data.substr(0, 3000), false, false, 1, 0);
+            data.remove_prefix(3000);
+        }
+
+        ushard->write(key, data, true, false, 1, 0);
+
+        expected[key] = value;
+    }
+
+    ushard->seal(true, &cb);
+    ushard->flush(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+
+    verify(ushard.get(), expected);
+
+    ushard->compact(&cb);
+
+    verify(ushard.get(), expected);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -0,0 +1,143 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+#include <map>
+#include <set>
+
+
+using namespace tyrtech;
+
+
+using entries_t =
+        std::map<std::string, std::string>;
+
+using slice_set_t =
+        std::set<const tyrdbs::slice*>;
+
+
+slice_set_t slice_set(tyrdbs::ushard* ushard)
+{
+    slice_set_t slices;
+
+    for (auto&& slice : ushard->get_slices())
+    {
+        slices.insert(slice.get());
+    }
+
+    return slices;
+}
+
+
+void verify(tyrdbs::ushard* ushard, const entries_t& expected)
+{
+    entries_t entries;
+
+    auto&& it = ushard->begin();
+
+    while (it->next() == true)
+    {
+        assert(it->eor() == true);
+
+        if (it->deleted() == false)
+        {
+            entries[std::string(it->key())] = it->value();
+        }
+    }
+
+    assert(entries == expected);
+}
+
+
+void flush(tyrdbs::ushard* ushard, tests::meta_callback* cb)
+{
+    ushard->seal(true, cb);
+    ushard->flush(cb);
+}
+
+
+void merge(tyrdbs::ushard* ushard, tests::meta_callback* cb)
+{
+    while (cb->levels.size() != 0)
+    {
+        uint32_t level = *cb->levels.begin();
+        cb->levels.erase(cb->levels.begin());
+
+        ushard->merge(level, cb);
+    }
+}
+
+
+void test_policy(tyrdbs::compaction_policy::type policy)
+{
+    auto c = std::make_shared<tyrdbs::collection>("test", policy);
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    entries_t expected;
+    uint64_t idx = 1;
+
+    for (uint32_t batch = 0; batch < 16; batch++)
+    {
+        for (uint32_t ndx = 0; ndx < 1000; ndx++)
+        {
+            auto key = fmt::format("key{:06}", batch * 1000 + ndx);
+            auto value = fmt::format("value{}", idx);
+
+            ushard->write(key, value, true, false, idx++, 0);
+            expected[key] = value;
+        }
+
+        flush(ushard.get(), &cb);
+
+        auto&& before = slice_set(ushard.get());
+
+        merge(ushard.get(), &cb);
+
+        assert(slice_set(ushard.get()) == before);
+        assert(cb.removed == 0);
+
+        verify(ushard.get(), expected);
+    }
+
+    assert(cb.merges != 0);
+
+    for (uint32_t round = 0; round < 8; round++)
+    {
+        for (uint32_t ndx = round; ndx < 16000; ndx += 7)
+        {
+            auto key = fmt::format("key{:06}", ndx);
+            auto value = fmt::format("value{}", idx);
+
+            ushard->write(key, value, true, false, idx++, 0);
+            expected[key] = value;
+        }
+
+        flush(ushard.get(), &cb);
+        merge(ushard.get(), &cb);
+
+        verify(ushard.get(), expected);
+    }
+
+    assert(cb.removed != 0);
+
+    ushard->compact(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+
+    verify(ushard.get(), expected);
+}
+
+
+void test()
+{
+    test_policy(tyrdbs::compaction_policy::type::tiered);
+    test_policy(tyrdbs::compaction_policy::type::leveled);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
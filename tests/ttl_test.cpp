@@ -0,0 +1,118 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+
+using namespace tyrtech;
+
+
+std::string get(tyrdbs::ushard* ushard, const std::string_view& key)
+{
+    auto&& it = ushard->get(key);
+
+    if (it->next() == false)
+    {
+        return std::string();
+    }
+
+    assert(it->key().compare(key) == 0);
+
+    return std::string(it->value());
+}
+
+
+uint32_t count(tyrdbs::ushard* ushard)
+{
+    auto&& it = ushard->begin();
+
+    uint32_t count = 0;
+
+    while (it->next() == true)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+
+void flush(tyrdbs::ushard* ushard, tests::meta_callback* cb)
+{
+    ushard->seal(true, cb);
+    ushard->flush(cb);
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test");
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    uint64_t idx = 1;
+    uint32_t expires = tyrdbs::ushard::now() + 1;
+
+    for (uint32_t ndx = 0; ndx < 100; ndx++)
+    {
+        auto key = fmt::format("key{:04}", ndx);
+        ushard->write(key, key, true, false, idx++, expires);
+    }
+
+    flush(ushard.get(), &cb);
+
+    ushard->write("keep", "old", true, false, idx++, 0);
+    ushard->write("gone", "gone", true, false, idx++, tyrdbs::ushard::now() - 1);
+
+    flush(ushard.get(), &cb);
+
+    ushard->write("keep", "new", true, false, idx++, expires);
+
+    flush(ushard.get(), &cb);
+
+    assert(ushard->get_slices().size() == 3);
+
+    assert(get(ushard.get(), "key0000") == "key0000");
+    assert(get(ushard.get(), "keep") == "new");
+    assert(get(ushard.get(), "gone") == "");
+    assert(count(ushard.get()) == 101);
+
+    gt::sleep(2000);
+
+    assert(get(ushard.get(), "key0000") == "");
+    assert(get(ushard.get(), "keep") == "old");
+    assert(count(ushard.get()) == 1);
+
+    assert(ushard->expire(&cb) == 101);
+    assert(ushard->get_slices().size() == 1);
+
+    ushard->write("key0000", "key0000", true, false, idx++, tyrdbs::ushard::now() + 1);
+
+    flush(ushard.get(), &cb);
+
+    ushard->compact(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+    assert(ushard->get_slices().front()->key_count() == 2);
+
+    gt::sleep(2000);
+
+    ushard->write("key0001", "key0001", true, false, idx++, 0);
+
+    flush(ushard.get(), &cb);
+
+    ushard->compact(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+    assert(ushard->get_slices().front()->key_count() == 2);
+
+    assert(get(ushard.get(), "keep") == "old");
+    assert(get(ushard.get(), "key0000") == "");
+    assert(get(ushard.get(), "key0001") == "key0001");
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
@@ -16,7 +16,7 @@ using namespace tyrtech;
 
 struct test_cb : public tyrdbs::ushard::meta_callback
 {
-    void add(const tyrtech::tyrdbs::ushard::slice_ptr& slice) override
+    void add(uint32_t level, const tyrtech::tyrdbs::ushard::slices_t& slices) override
     {
     }
 
@@ -28,6 +28,14 @@ struct test_cb : public tyrdbs::ushard::meta_callback
         }
     }
 
+    void add_segment(const tyrtech::tyrdbs::value_log::segment_ptr& segment) override
+    {
+    }
+
+    void remove_segments(const tyrtech::tyrdbs::value_log::segments_t& segments) override
+    {
+    }
+
     std::vector<uint32_t> merge_requests;
     gt::condition merge_cond;
 
@@ -44,6 +52,14 @@ struct test_cb : public tyrdbs::ushard::meta_callback
         merge_requests.push_back(tier);
         merge_cond.signal();
     }
+
+    bool flush_request{false};
+
+    void flush() override
+    {
+        flush_request = true;
+        merge_cond.signal();
+    }
 };
 
 
@@ -55,6 +71,8 @@ struct thread_data
 
     tests::stats vs_stats;
     tests::stats vr_stats;
+    tests::stats vm_stats;
+    tests::stats vg_stats;
 
     thread_data(uint32_t thread_id)
       : thread_id(thread_id)
@@ -79,21 +97,34 @@ using data_sets_t =
         std::vector<data_set_t>;
 
 
-void insert(const data_set_t& data, test_cb* cb)
+void insert(const data_set_t& data, test_cb* cb, bool memtable)
 {
-    tyrdbs::slice_writer w;
-
     auto t1 = clock::now();
 
-    for (auto&& it : data)
+    if (memtable == true)
     {
-        std::string_view key(string_storage.data() + it.first.first, it.first.second);
-        w.add(key, key, true, false, it.second);
+        for (auto&& it : data)
+        {
+            std::string_view key(string_storage.data() + it.first.first, it.first.second);
+            cb->ushard->write(key, key, true, false, it.second, 0);
+        }
+
+        cb->ushard->seal(false, cb);
     }
+    else
+    {
+        tyrdbs::slice_writer w;
+
+        for (auto&& it : data)
+        {
+            std::string_view key(string_storage.data() + it.first.first, it.first.second);
+            w.add(key, key, true, false, it.second, 0);
+        }
 
-    w.flush();
+        w.flush();
 
-    cb->ushard->add(w.commit(), cb);
+        cb->ushard->add(w.commit(), cb);
+    }
 
     auto t2 = clock::now();
 
@@ -206,11 +237,95 @@ void verify_range(const data_set_t& data, tyrdbs::ushard* ushard, tests::stats*
     }
 }
 
+void verify_missing(const data_set_t& data, tyrdbs::ushard* ushard, tests::stats* s)
+{
+    std::string key;
+
+    for (auto&& it : data)
+    {
+        key.assign(string_storage.data() + it.first.first, it.first.second);
+        key.append("~");
+
+        std::unique_ptr<tyrdbs::iterator> db_it;
+
+        {
+            auto sw = s->stopwatch();
+            db_it = ushard->range(key, key);
+        }
+
+        assert(db_it->next() == false);
+
+        gt::yield();
+    }
+}
+
+void verify_get(const data_set_t& data, tyrdbs::ushard* ushard, tests::stats* s)
+{
+    std::string value;
+    std::string missing_key;
+
+    for (auto&& it : data)
+    {
+        std::string_view key(string_storage.data() + it.first.first,
+                             it.first.second);
+
+        std::unique_ptr<tyrdbs::iterator> db_it;
+
+        {
+            auto sw = s->stopwatch();
+            db_it = ushard->get(key);
+        }
+
+        while (db_it->next() == true)
+        {
+            assert(db_it->key().compare(key) == 0);
+            assert(db_it->deleted() == false);
+            assert(db_it->idx() == it.second);
+
+            auto&& value_part = db_it->value();
+            value.append(value_part.data(), value_part.size());
+        }
+
+        assert(key.compare(value) == 0);
+
+        value.clear();
+
+        missing_key.assign(key);
+        missing_key.append("~");
+
+        assert(ushard->get(missing_key)->next() == false);
+
+        gt::yield();
+    }
+}
+
 void merge_thread(test_cb* cb)
 {
+    gt::set_background(true);
+
     while (true)
     {
-        if (cb->merge_requests.size() != 0)
+        if (cb->flush_request == true)
+        {
+            cb->flush_request = false;
+
+            auto t1 = clock::now();
+            uint64_t flushed_keys = cb->ushard->flush(cb);
+            auto t2 = clock::now();
+
+            if (flushed_keys != 0)
+            {
+                uint64_t duration = t2 - t1;
+
+                logger::notice("flushed {} keys in {:.6f} s, {:.2f} keys/s",
+                               flushed_keys,
+                               duration / 1000000000.,
+                               flushed_keys * 1000000000. / duration);
+            }
+
+            gt::yield();
+        }
+        else if (cb->merge_requests.size() != 0)
         {
             uint32_t tier = cb->merge_requests[0];
             cb->merge_requests.erase(cb->merge_requests.begin());
@@ -269,19 +384,21 @@ void merge_thread(test_cb* cb)
 void test(const data_sets_t* data,
           const data_set_t* test_data,
           thread_data* t,
-          bool compact)
+          bool compact,
+          bool memtable,
+          tyrdbs::compaction_policy::type policy)
 {
     auto t1 = clock::now();
 
     test_cb cb;
 
-    cb.ushard = std::make_shared<tyrdbs::ushard>();
+    cb.ushard = std::make_shared<tyrdbs::ushard>(tyrdbs::compaction_policy::create(policy));
 
     gt::create_thread(merge_thread, &cb);
 
     for (auto&& set : *data)
     {
-        insert(set, &cb);
+        insert(set, &cb, memtable);
     }
 
     cb.compact = compact;
@@ -296,6 +413,8 @@ void test(const data_sets_t* data,
 
     verify_sequential(*test_data, cb.ushard.get(), &t->vs_stats);
     verify_range(*test_data, cb.ushard.get(), &t->vr_stats);
+    verify_missing(*test_data, cb.ushard.get(), &t->vm_stats);
+    verify_get(*test_data, cb.ushard.get(), &t->vg_stats);
 
     auto t2 = clock::now();
 
@@ -386,6 +505,14 @@ void report(thread_data* t)
     logger::notice("");
     logger::notice("random read [ns]:");
     t->vr_stats.report();
+
+    logger::notice("");
+    logger::notice("missing key read [ns]:");
+    t->vm_stats.report();
+
+    logger::notice("");
+    logger::notice("point get [ns]:");
+    t->vg_stats.report();
 }
 
 int main(int argc, const char* argv[])
@@ -434,6 +561,13 @@ int main(int argc, const char* argv[])
                   "12",
                   {"block cache size expressed as 2^bits (default is 12)"});
 
+    cmd.add_param("merge-io-rate",
+                  nullptr,
+                  "merge-io-rate",
+                  "pages",
+                  "0",
+                  {"maximum merge I/O rate in pages per second (default is 0, unlimited)"});
+
     cmd.add_flag("preallocate-space",
                  nullptr,
                  "preallocate-space",
@@ -444,6 +578,16 @@ int main(int argc, const char* argv[])
                  "compact",
                  {"compact ushard before reading"});
 
+    cmd.add_flag("memtable",
+                 nullptr,
+                 "memtable",
+                 {"insert data through the memtable"});
+
+    cmd.add_flag("leveled",
+                 nullptr,
+                 "leveled",
+                 {"use leveled compaction instead of size-tiered"});
+
     cmd.add_param("input-data",
                   nullptr,
                   "input-data",
@@ -486,6 +630,8 @@ int main(int argc, const char* argv[])
                         cmd.get<uint32_t>("write-cache-bits"),
                         cmd.flag("preallocate-space"));
 
+    storage::limit_background_io(cmd.get<uint64_t>("merge-io-rate"), 0);
+
     std::vector<thread_data> td;
 
     for (uint32_t i = 0; i < cmd.get<uint32_t>("threads"); i++)
@@ -495,7 +641,15 @@ int main(int argc, const char* argv[])
 
     for (uint32_t i = 0; i < td.size(); i++)
     {
-        gt::create_thread(test, &data, &test_data, &td[i], cmd.flag("compact"));
+        gt::create_thread(test,
+                          &data,
+                          &test_data,
+                          &td[i],
+                          cmd.flag("compact"),
+                          cmd.flag("memtable"),
+                          cmd.flag("leveled") ?
+                                  tyrdbs::compaction_policy::type::leveled :
+                                  tyrdbs::compaction_policy::type::tiered);
     }
 
     auto t1 = clock::now();
@@ -0,0 +1,199 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+#include <random>
+#include <map>
+
+
+using namespace tyrtech;
+
+
+using entries_t =
+        std::map<std::string, std::string>;
+
+
+static constexpr uint32_t value_threshold{1024};
+
+
+void read(tyrdbs::iterator* it, entries_t* entries)
+{
+    std::string key;
+    std::string value;
+
+    while (it->next() == true)
+    {
+        assert(it->indirect() == false);
+
+        if (key.compare(it->key()) != 0)
+        {
+            assert(value.size() == 0);
+            key.assign(it->key());
+        }
+
+        value.append(it->value());
+
+        if (it->eor() == true)
+        {
+            if (it->deleted() == false)
+            {
+                (*entries)[key] = std::move(value);
+            }
+
+            value.clear();
+        }
+    }
+
+    assert(value.size() == 0);
+}
+
+
+void verify(tyrdbs::ushard* ushard, const entries_t& expected)
+{
+    entries_t entries;
+    read(ushard->begin().get(), &entries);
+
+    assert(entries == expected);
+
+    entries.clear();
+
+    tyrdbs::slice::key_views_t keys;
+
+    for (auto&& it : expected)
+    {
+        read(ushard->get(it.first).get(), &entries);
+        keys.push_back(it.first);
+    }
+
+    assert(entries == expected);
+
+    entries.clear();
+    read(ushard->multi_get(std::move(keys)).get(), &entries);
+
+    assert(entries == expected);
+}
+
+
+void write(tyrdbs::ushard* ushard,
+           const std::string& key,
+           const std::string& value,
+           uint64_t idx)
+{
+    std::string_view data(value);
+
+    while (data.size() > 3000)
+    {
+        ushard->write(key, data.substr(0, 3000), false, false, idx, 0);
+        data.remove_prefix(3000);
+    }
+
+    ushard->write(key, data, true, false, idx, 0);
+}
+
+
+std::string value_of(std::mt19937* rnd, uint32_t round)
+{
+    uint32_t size = (*rnd)() % 4 == 0 ? 1000 + (*rnd)() % 40000 : 16;
+
+    std::string value(size, 'a' + round);
+
+    for (uint32_t i = 0; i < size; i += 97)
+    {
+        value[i] = 'a' + (*rnd)() % 26;
+    }
+
+    return value;
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test");
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+    ushard->set_value_threshold(value_threshold);
+
+    std::mt19937 rnd(0);
+
+    entries_t expected;
+
+    uint64_t idx = 1;
+
+    for (uint32_t round = 0; round < 4; round++)
+    {
+        for (uint32_t ndx = round; ndx < 5000; ndx += 1 + rnd() % 3)
+        {
+            auto key = fmt::format("key{:06}", ndx);
+
+            if (rnd() % 16 == 0)
+            {
+                ushard->write(key, std::string_view(), true, true, idx++, 0);
+                expected.erase(key);
+
+                continue;
+            }
+
+            auto&& value = value_of(&rnd, round);
+
+            write(ushard.get(), key, value, idx++);
+            expected[key] = std::move(value);
+        }
+
+        ushard->seal(true, &cb);
+        ushard->flush(&cb);
+
+        verify(ushard.get(), expected);
+    }
+
+    assert(cb.added_segments == 4);
+    assert(ushard->get_segments().size() == 4);
+
+    for (auto&& slice : ushard->get_slices())
+    {
+        assert(slice->segments().size() == 1);
+    }
+
+    ushard->compact(&cb);
+
+    assert(ushard->get_slices().size() == 1);
+    assert(ushard->get_slices()[0]->segments().size() == 4);
+
+    verify(ushard.get(), expected);
+
+    for (uint32_t ndx = 0; ndx < 5000; ndx++)
+    {
+        auto key = fmt::format("key{:06}", ndx);
+
+        if (ndx % 2 == 0)
+        {
+            ushard->write(key, std::string_view(), true, true, idx++, 0);
+            expected.erase(key);
+        }
+        else
+        {
+            ushard->write(key, "small", true, false, idx++, 0);
+            expected[key] = "small";
+        }
+    }
+
+    ushard->seal(true, &cb);
+    ushard->flush(&cb);
+
+    assert(cb.added_segments == 4);
+
+    verify(ushard.get(), expected);
+
+    ushard->compact(&cb);
+
+    assert(cb.removed_segments == 4);
+    assert(ushard->get_segments().size() == 0);
+
+    verify(ushard.get(), expected);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
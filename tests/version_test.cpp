@@ -0,0 +1,80 @@
+#include <tyrdbs/collection.h>
+#include <tests/fixture.h>
+
+
+using namespace tyrtech;
+
+
+uint64_t count(const tyrdbs::ushard::version_ptr& version)
+{
+    uint64_t keys = 0;
+
+    for (auto&& slice : *version)
+    {
+        auto&& it = slice->begin();
+
+        while (it->next() == true)
+        {
+            keys += it->eor() == true ? 1 : 0;
+        }
+    }
+
+    return keys;
+}
+
+
+void test()
+{
+    auto c = std::make_shared<tyrdbs::collection>("test");
+
+    tests::meta_callback cb;
+
+    auto&& ushard = c->get_ushard(1, true);
+
+    assert(ushard->get_version()->size() == 0);
+
+    uint64_t idx = 1;
+
+    for (uint32_t batch = 0; batch < 8; batch++)
+    {
+        for (uint32_t ndx = 0; ndx < 1000; ndx++)
+        {
+            auto key = fmt::format("key{:06}", ndx);
+            ushard->write(key, fmt::format("value{}", idx), true, false, idx, 0);
+        }
+
+        idx++;
+
+        auto&& version = ushard->get_version();
+
+        ushard->seal(true, &cb);
+        ushard->flush(&cb);
+
+        assert(version->size() == batch);
+        assert(ushard->get_version() != version);
+        assert(ushard->get_version() == ushard->get_version());
+    }
+
+    auto&& version = ushard->get_version();
+
+    assert(version->size() == 8);
+
+    for (uint32_t i = 1; i < version->size(); i++)
+    {
+        assert((*version)[i - 1]->max_idx() > (*version)[i]->max_idx());
+    }
+
+    ushard->compact(&cb);
+
+    assert(version->size() == 8);
+    assert(count(version) == 8000);
+
+    assert(ushard->get_version()->size() == 1);
+    assert(count(ushard->get_version()) == 1000);
+}
+
+
+int main()
+{
+    return tests::run(test);
+}
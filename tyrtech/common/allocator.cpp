@@ -98,6 +98,48 @@ void allocator::free(uint32_t idx, uint32_t size)
     m_idx_set.insert((static_cast<uint64_t>(idx) << 32) | size);
 }
 
+bool allocator::reserve(uint32_t idx, uint32_t size)
+{
+    auto it = m_idx_set.upper_bound((static_cast<uint64_t>(idx) << 32) | 0xffffffffU);
+
+    if (it == m_idx_set.begin())
+    {
+        return false;
+    }
+
+    --it;
+
+    uint32_t free_idx = *it >> 32;
+    uint32_t free_size = *it & 0xffffffffU;
+
+    if (static_cast<uint64_t>(idx) + size > static_cast<uint64_t>(free_idx) + free_size)
+    {
+        return false;
+    }
+
+    m_idx_set.erase(it);
+    m_free_set.erase((static_cast<uint64_t>(free_size) << 32) | free_idx);
+
+    if (free_idx < idx)
+    {
+        m_free_set.insert((static_cast<uint64_t>(idx - free_idx) << 32) | free_idx);
+        m_idx_set.insert((static_cast<uint64_t>(free_idx) << 32) | (idx - free_idx));
+    }
+
+    if (idx + size < free_idx + free_size)
+    {
+        uint32_t next_idx = idx + size;
+        uint32_t next_size = free_idx + free_size - next_idx;
+
+        m_free_set.insert((static_cast<uint64_t>(next_size) << 32) | next_idx);
+        m_idx_set.insert((static_cast<uint64_t>(next_idx) << 32) | next_size);
+    }
+
+    m_size += size;
+
+    return true;
+}
+
 void allocator::extend(uint32_t size)
 {
     m_size += size;
@@ -15,6 +15,7 @@ class allocator : private disallow_copy
 public:
     uint32_t allocate(uint32_t size);
     void free(uint32_t idx, uint32_t size);
+    bool reserve(uint32_t idx, uint32_t size);
 
     void extend(uint32_t size);
 
@@ -15,4 +15,13 @@ uint64_t now() noexcept
     return static_cast<uint64_t>(tp.tv_sec) * 1000000000 + tp.tv_nsec;
 }
 
+uint64_t realtime() noexcept
+{
+    timespec tp;
+
+    clock_gettime(CLOCK_REALTIME, &tp);
+
+    return static_cast<uint64_t>(tp.tv_sec) * 1000000000 + tp.tv_nsec;
+}
+
 }
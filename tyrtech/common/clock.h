@@ -8,5 +8,6 @@ namespace tyrtech::clock {
 
 
 uint64_t now() noexcept;
+uint64_t realtime() noexcept;
 
 }
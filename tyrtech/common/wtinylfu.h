@@ -38,6 +38,11 @@ public:
         return it->item;
     }
 
+    bool contains(const Key& key)
+    {
+        return find(key) != iterator_t();
+    }
+
     Item set(const Key& key, const Item& item)
     {
         assert(likely(key != Key()));
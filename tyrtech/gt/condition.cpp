@@ -6,16 +6,24 @@ namespace tyrtech::gt {
 
 void condition::wait()
 {
-    m_wait_queue.push_back(current_context());
+    if (is_background() == true)
+    {
+        m_background_wait_queue.push_back(current_context());
+    }
+    else
+    {
+        m_wait_queue.push_back(current_context());
+    }
+
     yield(false);
 }
 
 void condition::signal()
 {
-    if (m_wait_queue.empty() == false)
+    if (auto queue = next_queue(); queue != nullptr)
     {
-        context_t ctx = *m_wait_queue.front_item();
-        m_wait_queue.pop_front();
+        context_t ctx = *queue->front_item();
+        queue->pop_front();
 
         enqueue(ctx);
     }
@@ -23,10 +31,10 @@ void condition::signal()
 
 void condition::signal_all()
 {
-    while (m_wait_queue.empty() == false)
+    while (auto queue = next_queue())
     {
-        context_t ctx = *m_wait_queue.front_item();
-        m_wait_queue.pop_front();
+        context_t ctx = *queue->front_item();
+        queue->pop_front();
 
         enqueue(ctx);
     }
@@ -40,8 +48,24 @@ condition::condition(condition&& other)
 condition& condition::operator=(condition&& other)
 {
     m_wait_queue = std::move(other.m_wait_queue);
+    m_background_wait_queue = std::move(other.m_background_wait_queue);
 
     return *this;
 }
 
+context_queue_t* condition::next_queue()
+{
+    if (m_wait_queue.empty() == false)
+    {
+        return &m_wait_queue;
+    }
+
+    if (m_background_wait_queue.empty() == false)
+    {
+        return &m_background_wait_queue;
+    }
+
+    return nullptr;
+}
+
 }
@@ -24,6 +24,10 @@ public:
 
 private:
     context_queue_t m_wait_queue{new_context_queue()};
+    context_queue_t m_background_wait_queue{new_context_queue()};
+
+private:
+    context_queue_t* next_queue();
 };
 
 }
@@ -32,6 +32,7 @@ struct context : private disallow_copy, disallow_move
 
     state state{state::SUSPENDED};
     bool is_user_ctx{false};
+    bool is_background{false};
 
     uint32_t stack{static_cast<uint32_t>(-1)};
     uint32_t ctx{static_cast<uint32_t>(-1)};
@@ -183,6 +184,7 @@ context_t engine::create_context(bool is_user_ctx, function_t thread_callback)
 
     ctx->state = context::state::SUSPENDED;
     ctx->is_user_ctx = is_user_ctx;
+    ctx->is_background = current_ctx->is_background;
 
     if (is_user_ctx == true)
     {
@@ -362,6 +364,16 @@ context_t create_context(bool is_user_ctx, function_t thread_callback)
     return __engine->create_context(is_user_ctx, std::move(thread_callback));
 }
 
+void set_background(bool background)
+{
+    __engine->current_ctx->is_background = background;
+}
+
+bool is_background()
+{
+    return __engine->current_ctx->is_background;
+}
+
 void _set_terminate_callback(context_t ctx, function_t terminate_callback)
 {
     ctx->terminate_callback = std::move(terminate_callback);
@@ -34,6 +34,9 @@ int32_t sleep(uint64_t msec);
 context_t current_context();
 context_t create_context(bool is_user_ctx, function_t thread_callback);
 
+void set_background(bool background);
+bool is_background();
+
 context_queue_t new_context_queue();
 
 uint64_t user_contexts_waiting();
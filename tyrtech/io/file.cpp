@@ -7,6 +7,7 @@
 #include <io/queue_flow.h>
 
 #include <sys/file.h>
+#include <linux/io_uring.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -116,6 +117,18 @@ void file::allocate(int32_t mode, uint64_t offset, uint64_t size)
     }
 }
 
+void file::sync()
+{
+    queue_flow::resource r(*__queue_flow);
+
+    auto res = io::sync(m_fd, IORING_FSYNC_DATASYNC);
+
+    if (unlikely(res == -1))
+    {
+        throw error("{}: {}", m_path, system_error().message);
+    }
+}
+
 struct stat64 file::stat()
 {
     struct stat64 stat;
@@ -183,6 +196,7 @@ file& file::operator=(file&& other)
     other.m_fd = -1;
 
     std::memcpy(m_path, other.m_path, other.m_path_view.size());
+    m_path[other.m_path_view.size()] = 0;
     other.m_path[0] = 0;
 
     m_path_view = std::string_view(m_path, other.m_path_view.size());
@@ -1,5 +1,7 @@
 #include <io/queue_flow.h>
 
+#include <algorithm>
+
 
 namespace tyrtech::io {
 
@@ -17,7 +19,9 @@ queue_flow::resource::~resource()
 
 void queue_flow::acquire()
 {
-    while (m_enqueued == m_queue_size)
+    uint32_t queue_size = gt::is_background() ? m_background_queue_size : m_queue_size;
+
+    while (m_enqueued >= queue_size)
     {
         m_cond.wait();
     }
@@ -40,6 +44,7 @@ uint32_t queue_flow::enqueued() const
 
 queue_flow::queue_flow(uint32_t queue_size)
   : m_queue_size(queue_size)
+  , m_background_queue_size(std::max(1U, queue_size - (queue_size >> 2)))
 {
 }
 
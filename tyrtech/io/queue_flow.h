@@ -32,6 +32,7 @@ public:
 
 private:
     uint32_t m_queue_size{0};
+    uint32_t m_background_queue_size{0};
     uint32_t m_enqueued{0};
 
     gt::condition m_cond;
@@ -40,6 +40,11 @@ uint32_t cache::get(uint64_t cache_key)
     return m_cache.get(cache_key);
 }
 
+bool cache::contains(uint64_t cache_key)
+{
+    return m_cache.contains(cache_key);
+}
+
 char* cache::get_memory(uint32_t page)
 {
     uint16_t buffer_ndx = m_pages.slab_index(page);
@@ -17,6 +17,7 @@ public:
 
     void add(uint64_t cache_key, uint32_t page);
     uint32_t get(uint64_t cache_key);
+    bool contains(uint64_t cache_key);
 
     char* get_memory(uint32_t page);
 
@@ -14,6 +14,8 @@ static constexpr uint32_t page_mask{page_size - 1};
 
 static constexpr uint32_t file_pages_bits{25};
 
+static constexpr uint32_t max_read_ahead_pages{64};
+
 static constexpr uint32_t invalid_handle{static_cast<uint32_t>(-1)};
 
 
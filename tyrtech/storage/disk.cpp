@@ -13,6 +13,11 @@ void disk::read(uint32_t page, char* buff)
     m_file.pread(static_cast<uint64_t>(page) << page_bits, buff, page_size);
 }
 
+uint32_t disk::read(uint32_t page, iovec* iovec, uint32_t size)
+{
+    return m_file.preadv(static_cast<uint64_t>(page) << page_bits, iovec, size);
+}
+
 uint32_t disk::write(uint32_t page, iovec* iovec, uint32_t size)
 {
     return m_file.pwritev(static_cast<uint64_t>(page) << page_bits, iovec, size);
@@ -37,6 +42,19 @@ void disk::free(uint32_t page, uint32_t pages)
     m_blocks.free(page, pages);
 }
 
+void disk::reserve(uint32_t page, uint32_t pages)
+{
+    while (m_blocks.capacity() < page + pages)
+    {
+        allocate_space();
+    }
+
+    if (m_blocks.reserve(page, pages) == false)
+    {
+        throw error("{}: invalid data image", m_file.path());
+    }
+}
+
 void disk::remove(const extents_t& extents)
 {
     for (auto&& extent : extents)
@@ -48,6 +66,22 @@ void disk::remove(const extents_t& extents)
     }
 }
 
+void disk::reserve(const extents_t& extents)
+{
+    for (auto&& extent : extents)
+    {
+        uint32_t extent_page = extent >> 32;
+        uint32_t extent_pages = extent & 0xffffffffU;
+
+        reserve(extent_page, extent_pages);
+    }
+}
+
+void disk::sync()
+{
+    m_file.sync();
+}
+
 uint32_t disk::size() const
 {
     return m_blocks.size();
@@ -30,12 +30,17 @@ public:
 
 public:
     void read(uint32_t page, char* buff);
+    uint32_t read(uint32_t page, iovec* iovec, uint32_t size);
     uint32_t write(uint32_t page, iovec* iovec, uint32_t size);
 
     uint32_t allocate(uint32_t pages);
     void free(uint32_t page, uint32_t pages);
+    void reserve(uint32_t page, uint32_t pages);
 
     void remove(const extents_t& extents);
+    void reserve(const extents_t& extents);
+
+    void sync();
 
     uint32_t size() const;
     uint32_t capacity() const;
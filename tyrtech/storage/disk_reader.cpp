@@ -1,3 +1,5 @@
+#include <common/clock.h>
+#include <gt/engine.h>
 #include <storage/disk_reader.h>
 
 
@@ -9,36 +11,71 @@ const char* disk_reader::read(uint64_t cache_id, uint32_t file_page, const exten
     assert(likely(file_page < (1U << file_pages_bits)));
     uint64_t cache_key = (cache_id << file_pages_bits) | file_page;
 
-    auto mem_page = m_cache->get(cache_key);
-
-    if (mem_page != invalid_handle)
+    while (true)
     {
-        return m_cache->get_memory(mem_page);
-    }
+        auto mem_page = m_cache->get(cache_key);
 
-    mem_page = m_latch.acquire(cache_key);
+        if (mem_page != invalid_handle)
+        {
+            return m_cache->get_memory(mem_page);
+        }
 
-    if (mem_page == invalid_handle)
-    {
-        mem_page = m_cache->allocate();
-        m_latch.set(cache_key, mem_page);
+        auto& latched_page = m_latch.acquire(cache_key);
 
-        uint32_t disk_page = get_disk_page(file_page, extents);
-        m_disk->read(disk_page, m_cache->get_memory(mem_page));
+        if (latched_page == invalid_handle)
+        {
+            mem_page = m_cache->allocate();
+            m_latch.set(cache_key, mem_page);
+
+            try
+            {
+                read_page(get_disk_page(file_page, extents), m_cache->get_memory(mem_page));
+            }
+            catch (...)
+            {
+                fail(cache_key, mem_page);
+                throw;
+            }
+
+            m_latch.release(cache_key);
+        }
+        else
+        {
+            m_latch.wait_for(cache_key);
+        }
 
-        m_latch.release(cache_key);
-    }
-    else
-    {
-        m_latch.wait_for(cache_key);
+        mem_page = latched_page;
+
+        if (m_latch.remove(cache_key) == true && mem_page != invalid_handle)
+        {
+            m_cache->add(cache_key, mem_page);
+        }
+
+        if (mem_page != invalid_handle)
+        {
+            return m_cache->get_memory(mem_page);
+        }
     }
+}
+
+void disk_reader::read_ahead(uint64_t cache_id,
+                             uint32_t file_page,
+                             uint32_t pages,
+                             const extents_t& extents)
+{
+    assert(likely(file_page + pages <= (1U << file_pages_bits)));
 
-    if (m_latch.remove(cache_key) == true)
+    if (pages == 0)
     {
-        m_cache->add(cache_key, mem_page);
+        return;
     }
 
-    return m_cache->get_memory(mem_page);
+    gt::create_thread(&disk_reader::prefetch,
+                      this,
+                      cache_id,
+                      file_page,
+                      std::min(pages, max_read_ahead_pages),
+                      extents);
 }
 
 void disk_reader::remove(const extents_t& extents)
@@ -46,9 +83,10 @@ void disk_reader::remove(const extents_t& extents)
     m_disk->remove(extents);
 }
 
-disk_reader::disk_reader(disk* disk, cache* cache)
+disk_reader::disk_reader(disk* disk, cache* cache, io_limiter* io_limiter)
   : m_disk(disk)
   , m_cache(cache)
+  , m_io_limiter(io_limiter)
 {
     m_latch.set_empty_value(invalid_handle);
 }
@@ -75,4 +113,130 @@ uint32_t disk_reader::get_disk_page(uint32_t file_page, const extents_t& extents
     return disk_page;
 }
 
+void disk_reader::read_page(uint32_t disk_page, char* data)
+{
+    if (gt::is_background() == true)
+    {
+        m_io_limiter->acquire(1);
+        m_disk->read(disk_page, data);
+    }
+    else
+    {
+        auto t1 = clock::now();
+        m_disk->read(disk_page, data);
+        auto t2 = clock::now();
+
+        m_io_limiter->report_latency(t2 - t1);
+    }
+}
+
+void disk_reader::fail(uint64_t cache_key, uint32_t mem_page)
+{
+    m_latch.set(cache_key, invalid_handle);
+    m_latch.release(cache_key);
+    m_latch.remove(cache_key);
+
+    m_cache->free(mem_page);
+}
+
+void disk_reader::prefetch(uint64_t cache_id,
+                           uint32_t file_page,
+                           uint32_t pages,
+                           const extents_t& extents)
+{
+    uint64_t cache_keys[max_read_ahead_pages];
+    uint32_t mem_pages[max_read_ahead_pages];
+    iovec iov[max_read_ahead_pages];
+
+    uint32_t disk_page = invalid_handle;
+    uint32_t count = 0;
+
+    for (uint32_t ndx = 0; ndx < pages; ndx++)
+    {
+        uint64_t cache_key = (cache_id << file_pages_bits) | (file_page + ndx);
+        uint32_t page = get_disk_page(file_page + ndx, extents);
+
+        if (page == invalid_handle)
+        {
+            break;
+        }
+
+        bool skip = m_cache->contains(cache_key) == true ||
+                    m_latch.contains(cache_key) == true;
+
+        if (count != 0 && (skip == true || page != disk_page + count))
+        {
+            read_pages(disk_page, cache_keys, mem_pages, iov, count);
+            count = 0;
+        }
+
+        if (skip == true)
+        {
+            continue;
+        }
+
+        if (count == 0)
+        {
+            disk_page = page;
+        }
+
+        uint32_t mem_page = m_cache->allocate();
+
+        m_latch.acquire(cache_key);
+        m_latch.set(cache_key, mem_page);
+
+        cache_keys[count] = cache_key;
+        mem_pages[count] = mem_page;
+
+        iov[count].iov_base = m_cache->get_memory(mem_page);
+        iov[count].iov_len = page_size;
+
+        count++;
+    }
+
+    if (count != 0)
+    {
+        read_pages(disk_page, cache_keys, mem_pages, iov, count);
+    }
+}
+
+void disk_reader::read_pages(uint32_t disk_page,
+                             const uint64_t* cache_keys,
+                             const uint32_t* mem_pages,
+                             iovec* iov,
+                             uint32_t pages)
+{
+    if (gt::is_background() == true)
+    {
+        m_io_limiter->acquire(pages);
+    }
+
+    bool failed = false;
+
+    try
+    {
+        failed = m_disk->read(disk_page, iov, pages) != pages << page_bits;
+    }
+    catch (io::file::error&)
+    {
+        failed = true;
+    }
+
+    for (uint32_t ndx = 0; ndx < pages; ndx++)
+    {
+        if (failed == true)
+        {
+            fail(cache_keys[ndx], mem_pages[ndx]);
+            continue;
+        }
+
+        m_latch.release(cache_keys[ndx]);
+
+        if (m_latch.remove(cache_keys[ndx]) == true)
+        {
+            m_cache->add(cache_keys[ndx], mem_pages[ndx]);
+        }
+    }
+}
+
 }
@@ -4,6 +4,7 @@
 #include <storage/disk.h>
 #include <storage/cache.h>
 #include <storage/latch.h>
+#include <storage/io_limiter.h>
 
 
 namespace tyrtech::storage {
@@ -13,11 +14,12 @@ class disk_reader : private disallow_copy
 {
 public:
     const char* read(uint64_t cache_id, uint32_t file_page, const extents_t& extents);
+    void read_ahead(uint64_t cache_id, uint32_t file_page, uint32_t pages, const extents_t& extents);
 
     void remove(const extents_t& extents);
 
 public:
-    disk_reader(disk* disk, cache* cache);
+    disk_reader(disk* disk, cache* cache, io_limiter* io_limiter);
 
 private:
     using latch_t =
@@ -26,11 +28,22 @@ private:
 private:
     disk* m_disk{nullptr};
     cache* m_cache{nullptr};
+    io_limiter* m_io_limiter{nullptr};
 
     latch_t m_latch;
 
 private:
     uint32_t get_disk_page(uint32_t file_page, const extents_t& extents);
+
+    void read_page(uint32_t disk_page, char* data);
+    void fail(uint64_t cache_key, uint32_t mem_page);
+
+    void prefetch(uint64_t cache_id, uint32_t file_page, uint32_t pages, const extents_t& extents);
+    void read_pages(uint32_t disk_page,
+                    const uint64_t* cache_keys,
+                    const uint32_t* mem_pages,
+                    iovec* iov,
+                    uint32_t pages);
 };
 
 }
@@ -33,7 +33,14 @@ void disk_writer::allocate_page(state* state)
 {
     assert(likely(state->mem_page == invalid_handle));
 
-    while (m_dirty_pages >= m_max_dirty_pages)
+    uint32_t max_dirty_pages = m_max_dirty_pages;
+
+    if (gt::is_background() == true)
+    {
+        max_dirty_pages = m_max_background_dirty_pages;
+    }
+
+    while (m_dirty_pages >= max_dirty_pages)
     {
         start_global_flush();
         m_dirty_pages_cond.wait();
@@ -88,10 +95,15 @@ void disk_writer::remove(state* state)
     m_dirty_pages_cond.signal_all();
 }
 
-disk_writer::disk_writer(disk* disk, cache* cache, uint32_t write_cache_bits)
+disk_writer::disk_writer(disk* disk,
+                         cache* cache,
+                         io_limiter* io_limiter,
+                         uint32_t write_cache_bits)
   : m_disk(disk)
   , m_cache(cache)
+  , m_io_limiter(io_limiter)
   , m_max_dirty_pages(1U << write_cache_bits)
+  , m_max_background_dirty_pages(m_max_dirty_pages - (m_max_dirty_pages >> 2))
 {
 }
 
@@ -157,6 +169,8 @@ void disk_writer::flush_pages(state* state, bool wait)
             ++it;
         }
 
+        m_io_limiter->acquire(size);
+
         auto res = m_disk->write(disk_page, iov, size);
 
         if (res != (size << page_bits))
@@ -199,6 +213,8 @@ void disk_writer::start_global_flush()
 
 void disk_writer::flush_thread()
 {
+    gt::set_background(false);
+
     uint32_t e = m_states.begin();
 
     while (e != invalid_handle)
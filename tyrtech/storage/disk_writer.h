@@ -5,6 +5,7 @@
 #include <gt/condition.h>
 #include <storage/disk.h>
 #include <storage/cache.h>
+#include <storage/io_limiter.h>
 
 
 namespace tyrtech::storage {
@@ -49,7 +50,10 @@ public:
     void remove(state* state);
 
 public:
-    disk_writer(disk* disk, cache* cache, uint32_t write_cache_bits);
+    disk_writer(disk* disk,
+                cache* cache,
+                io_limiter* io_limiter,
+                uint32_t write_cache_bits);
 
 private:
     using latch_t =
@@ -61,8 +65,10 @@ private:
 private:
     disk* m_disk{nullptr};
     cache* m_cache{nullptr};
+    io_limiter* m_io_limiter{nullptr};
 
     uint32_t m_max_dirty_pages{0};
+    uint32_t m_max_background_dirty_pages{0};
     uint32_t m_dirty_pages{0};
 
     gt::condition m_dirty_pages_cond;
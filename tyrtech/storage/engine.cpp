@@ -11,9 +11,13 @@ struct engine : private disallow_copy, disallow_move
     disk disk;
     cache cache;
 
+    io_limiter io_limiter;
+
     disk_reader disk_reader;
     disk_writer disk_writer;
 
+    metadata_log metadata_log;
+
     file_reader create_reader(file_descriptor&& descriptor);
     file_writer create_writer();
     uint32_t capacity() const;
@@ -32,8 +36,9 @@ engine::engine(io::file file,
                bool preallocate_space)
   : disk(std::move(file), preallocate_space)
   , cache(cache_bits)
-  , disk_reader(&disk, &cache)
-  , disk_writer(&disk, &cache, write_cache_bits)
+  , disk_reader(&disk, &cache, &io_limiter)
+  , disk_writer(&disk, &cache, &io_limiter, write_cache_bits)
+  , metadata_log(&disk)
 {
     assert(likely(cache_bits > 6));
     assert(likely(cache_bits > write_cache_bits));
@@ -69,6 +74,41 @@ file_writer create_writer()
     return file_writer(&__engine->disk_writer);
 }
 
+void reserve(const extents_t& extents)
+{
+    __engine->disk.reserve(extents);
+}
+
+metadata_log::records_t load_metadata()
+{
+    return __engine->metadata_log.load();
+}
+
+void append_metadata(const std::string_view& record)
+{
+    __engine->metadata_log.append(record);
+}
+
+void rewrite_metadata(const metadata_log::records_t& records)
+{
+    __engine->metadata_log.rewrite(records);
+}
+
+uint32_t metadata_size()
+{
+    return __engine->metadata_log.size();
+}
+
+void limit_background_io(uint64_t max_rate, uint64_t target_latency)
+{
+    __engine->io_limiter.set_limit(max_rate, target_latency);
+}
+
+uint64_t background_io_rate()
+{
+    return __engine->io_limiter.rate();
+}
+
 uint32_t capacity()
 {
     return __engine->disk.capacity();
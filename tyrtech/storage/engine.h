@@ -3,6 +3,7 @@
 
 #include <storage/file_reader.h>
 #include <storage/file_writer.h>
+#include <storage/metadata_log.h>
 
 
 namespace tyrtech::storage {
@@ -22,4 +23,14 @@ uint64_t new_cache_id();
 file_reader create_reader(file_descriptor&& descriptor);
 file_writer create_writer();
 
+void reserve(const extents_t& extents);
+
+metadata_log::records_t load_metadata();
+void append_metadata(const std::string_view& record);
+void rewrite_metadata(const metadata_log::records_t& records);
+uint32_t metadata_size();
+
+void limit_background_io(uint64_t max_rate, uint64_t target_latency);
+uint64_t background_io_rate();
+
 }
@@ -42,6 +42,27 @@ uint32_t file_reader::pread(uint64_t offset, char* data, uint32_t size) const
     return requested_size - size;
 }
 
+void file_reader::read_ahead(uint64_t offset, uint32_t size) const
+{
+    if (offset >= m_descriptor.size || size == 0)
+    {
+        return;
+    }
+
+    if (offset + size > m_descriptor.size)
+    {
+        size = m_descriptor.size - offset;
+    }
+
+    uint32_t first_page = offset >> page_bits;
+    uint32_t last_page = (offset + size - 1) >> page_bits;
+
+    m_reader->read_ahead(m_descriptor.cache_id,
+                         first_page,
+                         last_page - first_page + 1,
+                         m_descriptor.extents);
+}
+
 void file_reader::unlink()
 {
     m_reader->remove(m_descriptor.extents);
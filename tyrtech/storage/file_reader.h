@@ -11,6 +11,7 @@ class file_reader : private disallow_copy
 {
 public:
     uint32_t pread(uint64_t offset, char* data, uint32_t size) const;
+    void read_ahead(uint64_t offset, uint32_t size) const;
 
     const file_descriptor& descriptor() const;
     const extents_t& extents() const;
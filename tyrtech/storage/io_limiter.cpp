@@ -0,0 +1,118 @@
+#include <common/branch_prediction.h>
+#include <common/clock.h>
+#include <gt/engine.h>
+#include <storage/io_limiter.h>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace tyrtech::storage {
+
+
+void io_limiter::acquire(uint32_t pages)
+{
+    if (m_max_rate == 0 || gt::is_background() == false)
+    {
+        return;
+    }
+
+    while (true)
+    {
+        auto now = clock::now();
+
+        adjust(now);
+        refill(now);
+
+        if (m_tokens > 0)
+        {
+            break;
+        }
+
+        gt::sleep(wait_interval);
+    }
+
+    m_tokens -= pages;
+}
+
+void io_limiter::report_latency(uint64_t latency)
+{
+    if (m_max_rate == 0)
+    {
+        return;
+    }
+
+    m_latency = (m_latency * 7 + latency) >> 3;
+    m_samples++;
+
+    adjust(clock::now());
+}
+
+void io_limiter::set_limit(uint64_t max_rate, uint64_t target_latency)
+{
+    m_max_rate = max_rate;
+    m_min_rate = std::min(max_rate, std::max(min_burst_rate, max_rate >> 6));
+    m_rate = max_rate;
+
+    m_target_latency = target_latency;
+    m_latency = 0;
+    m_samples = 0;
+
+    m_tokens = 0;
+    m_credit = 0;
+
+    m_last_refill = clock::now();
+    m_last_adjust = m_last_refill;
+}
+
+uint64_t io_limiter::rate() const
+{
+    return m_rate;
+}
+
+void io_limiter::refill(uint64_t now)
+{
+    assert(likely(m_rate != 0));
+
+    uint64_t elapsed = std::min(now - m_last_refill, burst_interval);
+
+    m_credit += elapsed * m_rate;
+    m_last_refill = now;
+
+    uint64_t tokens = m_credit / 1000000000;
+
+    if (tokens == 0)
+    {
+        return;
+    }
+
+    m_credit -= tokens * 1000000000;
+
+    int64_t max_tokens = std::max(1UL, burst_interval * m_rate / 1000000000);
+
+    m_tokens = std::min(max_tokens, m_tokens + static_cast<int64_t>(tokens));
+}
+
+void io_limiter::adjust(uint64_t now)
+{
+    if (now - m_last_adjust < adjust_interval)
+    {
+        return;
+    }
+
+    bool congested = m_samples != 0 && m_latency > m_target_latency;
+
+    if (m_target_latency != 0 && congested == true)
+    {
+        m_rate = std::max(m_min_rate, (m_rate >> 1) + (m_rate >> 2));
+    }
+    else
+    {
+        m_rate = std::min(m_max_rate, m_rate + std::max(1UL, m_max_rate >> 4));
+    }
+
+    m_samples = 0;
+    m_last_adjust = now;
+}
+
+}
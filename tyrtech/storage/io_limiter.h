@@ -0,0 +1,54 @@
+#pragma once
+
+
+#include <common/disallow_copy.h>
+#include <common/disallow_move.h>
+
+#include <cstdint>
+
+
+namespace tyrtech::storage {
+
+
+class io_limiter : private disallow_copy, disallow_move
+{
+public:
+    static constexpr uint64_t burst_interval{100000000};
+    static constexpr uint64_t adjust_interval{100000000};
+    static constexpr uint32_t wait_interval{1};
+
+public:
+    void acquire(uint32_t pages);
+    void report_latency(uint64_t latency);
+
+    void set_limit(uint64_t max_rate, uint64_t target_latency);
+
+    uint64_t rate() const;
+
+public:
+    io_limiter() = default;
+
+private:
+    static constexpr uint64_t min_burst_rate{1000000000 / burst_interval};
+
+private:
+    uint64_t m_max_rate{0};
+    uint64_t m_min_rate{0};
+    uint64_t m_rate{0};
+
+    uint64_t m_target_latency{0};
+    uint64_t m_latency{0};
+    uint32_t m_samples{0};
+
+    int64_t m_tokens{0};
+    uint64_t m_credit{0};
+
+    uint64_t m_last_refill{0};
+    uint64_t m_last_adjust{0};
+
+private:
+    void refill(uint64_t now);
+    void adjust(uint64_t now);
+};
+
+}
@@ -24,6 +24,10 @@ public:
 
             it = m_entries.insert(typename entries_t::value_type(key, std::move(e))).first;
         }
+        else if (it->second.released == true && it->second.value == m_empty_value)
+        {
+            it->second.released = false;
+        }
 
         it->second.ref_count++;
 
@@ -39,6 +43,11 @@ public:
         it->second.cond.signal_all();
     }
 
+    bool contains(const Key& key) const
+    {
+        return m_entries.find(key) != m_entries.end();
+    }
+
     void wait_for(const Key& key)
     {
         auto it = m_entries.find(key);
@@ -0,0 +1,294 @@
+#include <common/branch_prediction.h>
+#include <storage/metadata_log.h>
+
+#include <crc32c.h>
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+
+
+namespace tyrtech::storage {
+
+
+metadata_log::records_t metadata_log::load()
+{
+    return std::move(m_records);
+}
+
+void metadata_log::append(const std::string_view& record)
+{
+    std::unique_lock<gt::mutex> lock(m_lock);
+
+    m_disk->sync();
+
+    write(record);
+
+    m_disk->sync();
+}
+
+void metadata_log::rewrite(const records_t& records)
+{
+    std::unique_lock<gt::mutex> lock(m_lock);
+
+    pages_t pages;
+    std::swap(m_pages, pages);
+
+    m_generation++;
+    m_sequence = 0;
+    m_prev_crc = 0;
+
+    m_pages.push_back(m_disk->allocate(1));
+
+    for (auto&& record : records)
+    {
+        write(record);
+    }
+
+    m_disk->sync();
+
+    write_superblock();
+
+    for (auto&& page : pages)
+    {
+        m_disk->free(page, 1);
+    }
+}
+
+uint32_t metadata_log::size() const
+{
+    return m_pages.size();
+}
+
+metadata_log::metadata_log(disk* disk)
+  : m_disk(disk)
+{
+    superblock sb;
+
+    if (find_superblock(&sb) == true)
+    {
+        recover(sb);
+    }
+    else
+    {
+        format();
+    }
+}
+
+void metadata_log::format()
+{
+    m_disk->reserve(0, superblock_pages);
+
+    m_generation = 1;
+    m_pages.push_back(m_disk->allocate(1));
+
+    write_superblock();
+}
+
+void metadata_log::recover(const superblock& sb)
+{
+    m_disk->reserve(0, superblock_pages);
+
+    m_generation = sb.generation;
+
+    uint32_t page = sb.first_page;
+    uint32_t resume_ndx = 0;
+
+    std::string record;
+
+    uint64_t sequence = 0;
+    uint32_t prev_crc = 0;
+
+    while (true)
+    {
+        page_t data;
+        bool valid = read_page(page, &data);
+
+        m_disk->reserve(page, 1);
+        m_pages.push_back(page);
+
+        if (valid == false)
+        {
+            break;
+        }
+
+        auto h = reinterpret_cast<const page_header*>(data.data());
+
+        if (h->generation != m_generation ||
+                h->sequence != sequence ||
+                h->prev_crc != prev_crc ||
+                h->size > page_payload_size)
+        {
+            break;
+        }
+
+        record.append(data.data() + sizeof(page_header), h->size);
+
+        sequence++;
+        prev_crc = h->crc;
+
+        if (h->last != 0)
+        {
+            m_records.emplace_back(std::move(record));
+            record.clear();
+
+            resume_ndx = m_pages.size();
+
+            m_sequence = sequence;
+            m_prev_crc = prev_crc;
+        }
+
+        page = h->next_page;
+    }
+
+    for (uint32_t ndx = resume_ndx + 1; ndx < m_pages.size(); ndx++)
+    {
+        m_disk->free(m_pages[ndx], 1);
+    }
+
+    m_pages.resize(resume_ndx + 1);
+}
+
+bool metadata_log::find_superblock(superblock* sb)
+{
+    if (m_disk->capacity() < superblock_pages)
+    {
+        return false;
+    }
+
+    bool damaged = false;
+
+    for (uint32_t page = 0; page < superblock_pages; page++)
+    {
+        superblock other;
+
+        if (read_superblock(page, &other) == false)
+        {
+            damaged |= other.signature == signature;
+            continue;
+        }
+
+        if (other.generation > sb->generation)
+        {
+            *sb = other;
+        }
+    }
+
+    if (sb->generation == 0 && damaged == true)
+    {
+        throw error("{}: invalid data image", m_disk->path());
+    }
+
+    return sb->generation != 0;
+}
+
+bool metadata_log::read_superblock(uint32_t page, superblock* sb)
+{
+    page_t data;
+    m_disk->read(page, data.data());
+
+    std::memcpy(sb, data.data(), sizeof(superblock));
+
+    if (sb->signature != signature)
+    {
+        return false;
+    }
+
+    return crc32c_update(0, sb, sizeof(superblock) - sizeof(sb->crc)) == sb->crc;
+}
+
+void metadata_log::write_superblock()
+{
+    superblock sb;
+
+    sb.generation = m_generation;
+    sb.first_page = m_pages.front();
+    sb.crc = crc32c_update(0, &sb, sizeof(superblock) - sizeof(sb.crc));
+
+    page_t data;
+    data.fill(0);
+
+    std::memcpy(data.data(), &sb, sizeof(superblock));
+
+    iovec iov;
+
+    iov.iov_base = data.data();
+    iov.iov_len = data.size();
+
+    if (m_disk->write(m_generation % superblock_pages, &iov, 1) != page_size)
+    {
+        throw error("{}: unable to write", m_disk->path());
+    }
+
+    m_disk->sync();
+}
+
+bool metadata_log::read_page(uint32_t page, page_t* data)
+{
+    if (page >= m_disk->capacity())
+    {
+        return false;
+    }
+
+    m_disk->read(page, data->data());
+
+    auto h = reinterpret_cast<const page_header*>(data->data());
+
+    return crc_of(*data) == h->crc;
+}
+
+void metadata_log::write(const std::string_view& record)
+{
+    std::string_view remaining = record;
+
+    do
+    {
+        uint16_t size = std::min(static_cast<size_t>(page_payload_size), remaining.size());
+
+        page_t data;
+        data.fill(0);
+
+        auto h = reinterpret_cast<page_header*>(data.data());
+
+        h->generation = m_generation;
+        h->sequence = m_sequence;
+        h->next_page = m_disk->allocate(1);
+        h->prev_crc = m_prev_crc;
+        h->size = size;
+        h->last = size == remaining.size();
+
+        std::memcpy(data.data() + sizeof(page_header), remaining.data(), size);
+
+        h->crc = crc_of(data);
+
+        iovec iov;
+
+        iov.iov_base = data.data();
+        iov.iov_len = data.size();
+
+        if (m_disk->write(m_pages.back(), &iov, 1) != page_size)
+        {
+            throw error("{}: unable to write", m_disk->path());
+        }
+
+        m_pages.push_back(h->next_page);
+
+        m_sequence++;
+        m_prev_crc = h->crc;
+
+        remaining.remove_prefix(size);
+    }
+    while (remaining.size() != 0);
+}
+
+uint32_t metadata_log::crc_of(const page_t& data)
+{
+    uint32_t crc = crc32c_update(0, data.data(), offsetof(page_header, crc));
+
+    crc = crc32c_update(crc,
+                        data.data() + sizeof(page_header),
+                        data.size() - sizeof(page_header));
+
+    return crc;
+}
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+
+#include <common/disallow_move.h>
+#include <gt/mutex.h>
+#include <storage/disk.h>
+
+#include <string>
+#include <array>
+
+
+namespace tyrtech::storage {
+
+
+class metadata_log : private disallow_copy, disallow_move
+{
+public:
+    DEFINE_EXCEPTION(disk::error, error);
+
+public:
+    using records_t =
+            std::vector<std::string>;
+
+public:
+    records_t load();
+
+    void append(const std::string_view& record);
+    void rewrite(const records_t& records);
+
+    uint32_t size() const;
+
+public:
+    metadata_log(disk* disk);
+
+private:
+    static constexpr uint64_t signature{0x676f6c6264727974UL};
+    static constexpr uint32_t superblock_pages{2};
+
+private:
+    struct superblock
+    {
+        uint64_t signature{metadata_log::signature};
+        uint64_t generation{0};
+        uint32_t first_page{invalid_handle};
+        uint32_t crc{0};
+    } __attribute__ ((packed));
+
+    struct page_header
+    {
+        uint64_t generation{0};
+        uint64_t sequence{0};
+        uint32_t next_page{invalid_handle};
+        uint32_t prev_crc{0};
+        uint16_t size{0};
+        uint8_t last{0};
+        uint8_t reserved{0};
+        uint32_t crc{0};
+    } __attribute__ ((packed));
+
+private:
+    static constexpr uint32_t page_payload_size{page_size - sizeof(page_header)};
+
+private:
+    using page_t =
+            std::array<char, page_size>;
+
+    using pages_t =
+            std::vector<uint32_t>;
+
+private:
+    disk* m_disk{nullptr};
+
+    gt::mutex m_lock;
+
+    uint64_t m_generation{0};
+    uint64_t m_sequence{0};
+    uint32_t m_prev_crc{0};
+
+    pages_t m_pages;
+    records_t m_records;
+
+private:
+    void format();
+    void recover(const superblock& sb);
+
+    bool find_superblock(superblock* sb);
+    bool read_superblock(uint32_t page, superblock* sb);
+    void write_superblock();
+
+    bool read_page(uint32_t page, page_t* data);
+    void write(const std::string_view& record);
+
+    static uint32_t crc_of(const page_t& data);
+};
+
+}
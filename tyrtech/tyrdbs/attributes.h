@@ -10,11 +10,13 @@ namespace tyrtech::tyrdbs {
 struct data_attributes
 {
     uint64_t idx;
+    uint32_t expires;
 } __attribute__ ((packed));
 
 struct index_attributes
 {
     uint64_t location;
+    uint64_t key_count;
 } __attribute__ ((packed));
 
 }
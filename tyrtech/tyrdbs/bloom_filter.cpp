@@ -0,0 +1,138 @@
+#include <common/branch_prediction.h>
+#include <tyrdbs/bloom_filter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+
+namespace tyrtech::tyrdbs {
+
+
+static uint64_t rotl(uint64_t value, uint32_t bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdUL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53UL;
+    value ^= value >> 33;
+
+    return value;
+}
+
+uint64_t bloom_filter::hash(const std::string_view& key)
+{
+    const char* data = key.data();
+    uint32_t size = key.size();
+
+    uint64_t h = 0x9e3779b97f4a7c15UL ^ (size * 0x87c37b91114253d5UL);
+
+    while (size >= sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+
+        h ^= rotl(word * 0x87c37b91114253d5UL, 31) * 0x4cf5ad432745937fUL;
+        h = rotl(h, 27) * 5 + 0x52dce729;
+
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+
+    if (size != 0)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, data, size);
+
+        h ^= rotl(word * 0x87c37b91114253d5UL, 31) * 0x4cf5ad432745937fUL;
+    }
+
+    return mix(h);
+}
+
+bool bloom_filter::may_contain(uint64_t hash) const
+{
+    if (unlikely(m_blocks.size() == 0))
+    {
+        return true;
+    }
+
+    const uint64_t* block = block_for(hash);
+    uint64_t h = hash * 0x9e3779b97f4a7c15UL;
+
+    for (uint32_t i = 0; i < probes; i++)
+    {
+        uint32_t bit = (h >> (55 - i * 9)) & (block_bits - 1);
+
+        if ((block[bit >> 6] & (1UL << (bit & 63))) == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void bloom_filter::build(const hashes_t& hashes)
+{
+    uint64_t bits = static_cast<uint64_t>(hashes.size()) * bits_per_key;
+    uint64_t blocks = std::max((bits + block_bits - 1) / block_bits, 1UL);
+
+    m_blocks.assign(blocks * block_words, 0);
+
+    for (auto&& hash : hashes)
+    {
+        uint64_t* block = block_for(hash);
+        uint64_t h = hash * 0x9e3779b97f4a7c15UL;
+
+        for (uint32_t i = 0; i < probes; i++)
+        {
+            uint32_t bit = (h >> (55 - i * 9)) & (block_bits - 1);
+            block[bit >> 6] |= 1UL << (bit & 63);
+        }
+    }
+}
+
+void bloom_filter::resize(uint32_t size)
+{
+    assert(likely((size % (block_words * sizeof(uint64_t))) == 0));
+    m_blocks.resize(size / sizeof(uint64_t));
+}
+
+char* bloom_filter::data()
+{
+    return reinterpret_cast<char*>(m_blocks.data());
+}
+
+const char* bloom_filter::data() const
+{
+    return reinterpret_cast<const char*>(m_blocks.data());
+}
+
+uint32_t bloom_filter::size() const
+{
+    return m_blocks.size() * sizeof(uint64_t);
+}
+
+uint64_t* bloom_filter::block_for(uint64_t hash)
+{
+    uint64_t blocks = m_blocks.size() / block_words;
+    uint64_t ndx = ((hash >> 32) * blocks) >> 32;
+
+    return m_blocks.data() + ndx * block_words;
+}
+
+const uint64_t* bloom_filter::block_for(uint64_t hash) const
+{
+    uint64_t blocks = m_blocks.size() / block_words;
+    uint64_t ndx = ((hash >> 32) * blocks) >> 32;
+
+    return m_blocks.data() + ndx * block_words;
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+
+#include <common/disallow_copy.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class bloom_filter : private disallow_copy
+{
+public:
+    static constexpr uint32_t bits_per_key{10};
+
+public:
+    using hashes_t =
+            std::vector<uint64_t>;
+
+public:
+    static uint64_t hash(const std::string_view& key);
+
+public:
+    bool may_contain(uint64_t hash) const;
+
+    void build(const hashes_t& hashes);
+    void resize(uint32_t size);
+
+    char* data();
+    const char* data() const;
+
+    uint32_t size() const;
+
+private:
+    static constexpr uint32_t block_bits{512};
+    static constexpr uint32_t block_words{block_bits / 64};
+    static constexpr uint32_t probes{6};
+
+private:
+    using blocks_t =
+            std::vector<uint64_t>;
+
+private:
+    blocks_t m_blocks;
+
+private:
+    uint64_t* block_for(uint64_t hash);
+    const uint64_t* block_for(uint64_t hash) const;
+};
+
+}
@@ -0,0 +1,200 @@
+#include <common/buffered_writer.h>
+#include <tyrdbs/gorilla_writer.h>
+#include <tyrdbs/gorilla_decoder.h>
+#include <tyrdbs/chunk.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+
+namespace tyrtech::tyrdbs {
+
+
+std::string chunk::encode(const points_t& points, bool base)
+{
+    using writer_t =
+            buffered_writer<std::string>;
+
+    std::string data(sizeof(header) + (points.size() + 1) * max_point_size, '\0');
+
+    writer_t writer(&data);
+
+    header h;
+
+    h.samples = points.size();
+    h.flags = base ? base_flag : 0;
+
+    writer.write(h);
+
+    gorilla_writer<writer_t> encoder(&writer);
+
+    for (auto&& p : points)
+    {
+        encoder.write(p.timestamp, p.value);
+    }
+
+    encoder.flush();
+
+    data.resize(writer.offset());
+
+    return data;
+}
+
+void chunk::decode(const std::string_view& data, points_t* points)
+{
+    if (data.size() < sizeof(header))
+    {
+        throw invalid_data_error("chunk too small");
+    }
+
+    header h;
+    std::memcpy(&h, data.data(), sizeof(h));
+
+    gorilla_decoder decoder(h.samples,
+                            data.data() + sizeof(h),
+                            data.size() - sizeof(h));
+
+    points->reserve(points->size() + h.samples);
+
+    uint64_t timestamps[decode_batch_size];
+    uint64_t values[decode_batch_size];
+
+    while (true)
+    {
+        uint32_t count = decoder.decode(timestamps, values, decode_batch_size);
+
+        if (count == 0)
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            points->push_back(point{timestamps[i], values[i]});
+        }
+    }
+}
+
+bool chunk::is_base(const std::string_view& data)
+{
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+
+    return (data[offsetof(header, flags)] & base_flag) != 0;
+}
+
+void chunk::set_base(std::string* data)
+{
+    if (data->size() < sizeof(header))
+    {
+        throw invalid_data_error("chunk too small");
+    }
+
+    (*data)[offsetof(header, flags)] |= base_flag;
+}
+
+std::string chunk::key(const std::string_view& series, uint64_t bucket)
+{
+    if (series.find('\0') != std::string_view::npos)
+    {
+        throw invalid_data_error("series name must not contain null characters");
+    }
+
+    uint64_t encoded_bucket = __builtin_bswap64(bucket);
+
+    std::string key;
+
+    key.reserve(series.size() + 1 + sizeof(encoded_bucket));
+
+    key.append(series.data(), series.size());
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char*>(&encoded_bucket), sizeof(encoded_bucket));
+
+    return key;
+}
+
+uint64_t chunk::bucket(uint64_t timestamp, uint64_t bucket_size)
+{
+    return timestamp - timestamp % bucket_size;
+}
+
+void chunk::sort(points_t* points)
+{
+    std::stable_sort(points->begin(), points->end(), [](auto&& p1, auto&& p2)
+    {
+        return p1.timestamp < p2.timestamp;
+    });
+
+    auto out = points->begin();
+
+    for (auto it = points->begin(); it != points->end(); ++it)
+    {
+        auto next = it + 1;
+
+        if (next != points->end() && next->timestamp == it->timestamp)
+        {
+            continue;
+        }
+
+        *out++ = *it;
+    }
+
+    points->erase(out, points->end());
+}
+
+void chunk::merge(const points_t& older, points_t* points)
+{
+    points_t merged;
+    merged.reserve(older.size() + points->size());
+
+    auto it1 = older.begin();
+    auto it2 = points->begin();
+
+    while (it1 != older.end() || it2 != points->end())
+    {
+        if (it2 == points->end() || (it1 != older.end() && it1->timestamp < it2->timestamp))
+        {
+            merged.push_back(*it1++);
+            continue;
+        }
+
+        if (it1 != older.end() && it1->timestamp == it2->timestamp)
+        {
+            ++it1;
+        }
+
+        merged.push_back(*it2++);
+    }
+
+    std::swap(merged, *points);
+}
+
+void chunk_merge_operator::merge(const std::string_view& key,
+                                 const std::string_view& older_value,
+                                 std::string* value) const
+{
+    if (chunk::is_base(*value) == true)
+    {
+        return;
+    }
+
+    chunk::points_t older;
+    chunk::points_t points;
+
+    chunk::decode(older_value, &older);
+    chunk::decode(*value, &points);
+
+    chunk::merge(older, &points);
+
+    *value = chunk::encode(points, chunk::is_base(older_value));
+}
+
+void chunk_merge_operator::truncate(const std::string_view& key, std::string* value) const
+{
+    chunk::set_base(value);
+}
+
+}
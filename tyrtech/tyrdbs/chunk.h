@@ -0,0 +1,68 @@
+#pragma once
+
+
+#include <common/exception.h>
+#include <tyrdbs/ushard.h>
+
+#include <string>
+#include <vector>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class chunk
+{
+public:
+    DEFINE_EXCEPTION(runtime_error, invalid_data_error);
+
+public:
+    static constexpr uint64_t max_bucket_size{0x7fffffffUL};
+
+public:
+    struct point
+    {
+        uint64_t timestamp;
+        uint64_t value;
+    };
+
+    using points_t =
+            std::vector<point>;
+
+public:
+    static std::string encode(const points_t& points, bool base);
+    static void decode(const std::string_view& data, points_t* points);
+
+    static bool is_base(const std::string_view& data);
+    static void set_base(std::string* data);
+
+    static std::string key(const std::string_view& series, uint64_t bucket);
+    static uint64_t bucket(uint64_t timestamp, uint64_t bucket_size);
+
+    static void sort(points_t* points);
+    static void merge(const points_t& older, points_t* points);
+
+private:
+    struct header
+    {
+        uint32_t samples{0};
+        uint8_t flags{0};
+    } __attribute__ ((packed));
+
+private:
+    static constexpr uint8_t base_flag{0x01};
+    static constexpr uint32_t max_point_size{16};
+    static constexpr uint32_t decode_batch_size{256};
+};
+
+
+class chunk_merge_operator : public ushard::merge_operator
+{
+public:
+    void merge(const std::string_view& key,
+               const std::string_view& older_value,
+               std::string* value) const override;
+    void truncate(const std::string_view& key, std::string* value) const override;
+};
+
+}
@@ -1,5 +1,6 @@
 #include <common/branch_prediction.h>
 #include <tyrdbs/collection.h>
+#include <tyrdbs/manifest.h>
 
 #include <cassert>
 
@@ -15,7 +16,9 @@ std::shared_ptr<ushard> collection::get_ushard(uint32_t ushard_id, bool auto_cre
     {
         if (auto_create == true)
         {
-            auto s = std::make_shared<ushard>();
+            auto s = std::make_shared<ushard>(compaction_policy::create(m_policy));
+            s->set_merge_operator(m_merge_operator);
+
             m_ushard_map[ushard_id] = s;
 
             return s;
@@ -47,12 +50,25 @@ void collection::drop()
     m_dropped = true;
 }
 
+void collection::restore(manifest* manifest)
+{
+    for (auto&& ushard_id : manifest->ushard_ids(name()))
+    {
+        auto&& s = get_ushard(ushard_id, true);
+        manifest->restore(name(), ushard_id, s.get());
+    }
+}
+
 std::string_view collection::name() const
 {
     return m_name_view;
 }
 
-collection::collection(const std::string_view& name)
+collection::collection(const std::string_view& name,
+                       compaction_policy::type policy,
+                       ushard::merge_operator_ptr merge_operator)
+  : m_policy(policy)
+  , m_merge_operator(std::move(merge_operator))
 {
     m_name_view = format_to(m_name, sizeof(m_name), "{}", name);
 }
@@ -7,6 +7,9 @@
 namespace tyrtech::tyrdbs {
 
 
+class manifest;
+
+
 class collection : private disallow_copy, disallow_move
 {
 public:
@@ -15,10 +18,14 @@ public:
     void drop_ushard(uint32_t ushard_id);
     void drop();
 
+    void restore(manifest* manifest);
+
     std::string_view name() const;
 
 public:
-    collection(const std::string_view& name);
+    collection(const std::string_view& name,
+               compaction_policy::type policy = compaction_policy::type::tiered,
+               ushard::merge_operator_ptr merge_operator = ushard::merge_operator_ptr());
     ~collection();
 
 private:
@@ -32,6 +39,9 @@ private:
     char m_name[256];
     std::string_view m_name_view;
 
+    compaction_policy::type m_policy{compaction_policy::type::tiered};
+    ushard::merge_operator_ptr m_merge_operator;
+
     ushard_map_t m_ushard_map;
 
     bool m_dropped{false};
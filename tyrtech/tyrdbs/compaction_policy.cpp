@@ -0,0 +1,346 @@
+#include <common/branch_prediction.h>
+#include <tyrdbs/compaction_policy.h>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace tyrtech::tyrdbs {
+
+
+std::unique_ptr<compaction_policy> compaction_policy::create(type policy_type)
+{
+    switch (policy_type)
+    {
+        case type::leveled:
+        {
+            return std::make_unique<leveled_policy>();
+        }
+        case type::tiered:
+        default:
+        {
+            return std::make_unique<tiered_policy>();
+        }
+    }
+}
+
+uint64_t compaction_policy::key_count(const slices_t& slices)
+{
+    uint64_t key_count = 0;
+
+    for (auto&& slice : slices)
+    {
+        key_count += slice->key_count();
+    }
+
+    return key_count;
+}
+
+uint64_t compaction_policy::key_count(const runs_t& runs)
+{
+    uint64_t count = 0;
+
+    for (auto&& run : runs)
+    {
+        count += key_count(run);
+    }
+
+    return count;
+}
+
+uint32_t tiered_policy::level_of(uint32_t level, const slices_t& run) const
+{
+    return (64 - __builtin_clzll(key_count(run))) >> 2;
+}
+
+uint32_t tiered_policy::ingest_level(const slices_t& run, const levels_t& levels) const
+{
+    return level_of(0, run);
+}
+
+void tiered_policy::insert(uint32_t level, slices_t run, levels_t* levels) const
+{
+    (*levels)[level].emplace_back(std::move(run));
+}
+
+bool tiered_policy::needs_merge(uint32_t level, const levels_t& levels) const
+{
+    auto it = levels.find(level);
+
+    if (it == levels.end())
+    {
+        return false;
+    }
+
+    return it->second.size() > max_runs_per_tier;
+}
+
+compaction_policy::task tiered_policy::plan(uint32_t level, const levels_t& levels)
+{
+    task t;
+
+    if (needs_merge(level, levels) == false)
+    {
+        return t;
+    }
+
+    for (auto&& run : levels.find(level)->second)
+    {
+        std::copy(run.begin(), run.end(), std::back_inserter(t.slices));
+    }
+
+    t.level = level;
+
+    return t;
+}
+
+compaction_policy::task tiered_policy::plan_compaction(const levels_t& levels) const
+{
+    task t;
+
+    for (auto&& it : levels)
+    {
+        for (auto&& run : it.second)
+        {
+            std::copy(run.begin(), run.end(), std::back_inserter(t.slices));
+        }
+    }
+
+    t.compact = true;
+    t.rewrite = true;
+
+    return t;
+}
+
+uint32_t leveled_policy::level_of(uint32_t level, const slices_t& run) const
+{
+    return level;
+}
+
+uint32_t leveled_policy::ingest_level(const slices_t& run, const levels_t& levels) const
+{
+    uint32_t target = 0;
+
+    for (uint32_t level = 0; level <= std::max(1U, last_level(levels)); level++)
+    {
+        auto it = levels.find(level);
+
+        if (it != levels.end() && overlaps(it->second, run) == true)
+        {
+            break;
+        }
+
+        target = level;
+    }
+
+    return target;
+}
+
+void leveled_policy::insert(uint32_t level, slices_t run, levels_t* levels) const
+{
+    auto& runs = (*levels)[level];
+
+    if (level == 0 || runs.size() == 0)
+    {
+        runs.emplace_back(std::move(run));
+        return;
+    }
+
+    assert(likely(runs.size() == 1));
+
+    auto& target = runs.front();
+
+    std::move(run.begin(), run.end(), std::back_inserter(target));
+    std::sort(target.begin(), target.end(), [](auto&& s1, auto&& s2)
+    {
+        return s1->min_key().compare(s2->min_key()) < 0;
+    });
+}
+
+bool leveled_policy::needs_merge(uint32_t level, const levels_t& levels) const
+{
+    auto it = levels.find(level);
+
+    if (it == levels.end())
+    {
+        return false;
+    }
+
+    if (level == 0)
+    {
+        return it->second.size() > max_level0_runs;
+    }
+
+    return key_count(it->second) > target_key_count(level);
+}
+
+compaction_policy::task leveled_policy::plan(uint32_t level, const levels_t& levels)
+{
+    task t;
+
+    if (needs_merge(level, levels) == false)
+    {
+        return t;
+    }
+
+    auto& runs = levels.find(level)->second;
+
+    if (level == 0)
+    {
+        for (auto&& run : runs)
+        {
+            std::copy(run.begin(), run.end(), std::back_inserter(t.slices));
+        }
+    }
+    else
+    {
+        t.slices.push_back(next_slice(level, runs));
+    }
+
+    std::string min_key = t.slices.front()->min_key();
+    std::string max_key = t.slices.front()->max_key();
+
+    for (auto&& slice : t.slices)
+    {
+        min_key = std::min(min_key, slice->min_key());
+        max_key = std::max(max_key, slice->max_key());
+    }
+
+    auto it = levels.find(level + 1);
+
+    if (it != levels.end())
+    {
+        add_overlapping(it->second, min_key, max_key, &t.slices);
+    }
+
+    t.level = level + 1;
+    t.compact = t.level >= last_level(levels);
+
+    return t;
+}
+
+compaction_policy::task leveled_policy::plan_compaction(const levels_t& levels) const
+{
+    task t;
+
+    for (auto&& it : levels)
+    {
+        for (auto&& run : it.second)
+        {
+            std::copy(run.begin(), run.end(), std::back_inserter(t.slices));
+        }
+    }
+
+    t.level = std::max(1U, last_level(levels));
+    t.compact = true;
+    t.rewrite = true;
+
+    return t;
+}
+
+leveled_policy::slice_ptr leveled_policy::next_slice(uint32_t level, const runs_t& runs)
+{
+    auto& cursor = m_cursors[level];
+
+    slice_ptr first;
+    slice_ptr next;
+
+    for (auto&& run : runs)
+    {
+        for (auto&& slice : run)
+        {
+            if (first == nullptr || slice->min_key().compare(first->min_key()) < 0)
+            {
+                first = slice;
+            }
+
+            if (slice->min_key().compare(cursor) <= 0)
+            {
+                continue;
+            }
+
+            if (next == nullptr || slice->min_key().compare(next->min_key()) < 0)
+            {
+                next = slice;
+            }
+        }
+    }
+
+    if (next == nullptr)
+    {
+        next = std::move(first);
+    }
+
+    cursor = next->max_key();
+
+    return next;
+}
+
+uint64_t leveled_policy::target_key_count(uint32_t level)
+{
+    uint64_t key_count = base_key_count;
+
+    for (uint32_t ndx = 1; ndx < level; ndx++)
+    {
+        key_count *= level_multiplier;
+    }
+
+    return key_count;
+}
+
+uint32_t leveled_policy::last_level(const levels_t& levels)
+{
+    uint32_t level = 0;
+
+    for (auto&& it : levels)
+    {
+        if (key_count(it.second) != 0)
+        {
+            level = std::max(level, it.first);
+        }
+    }
+
+    return level;
+}
+
+bool leveled_policy::overlaps(const runs_t& runs, const slices_t& run)
+{
+    for (auto&& slice : run)
+    {
+        slices_t overlapping;
+        add_overlapping(runs, slice->min_key(), slice->max_key(), &overlapping);
+
+        if (overlapping.size() != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void leveled_policy::add_overlapping(const runs_t& runs,
+                                     const std::string& min_key,
+                                     const std::string& max_key,
+                                     slices_t* slices)
+{
+    for (auto&& run : runs)
+    {
+        for (auto&& slice : run)
+        {
+            if (slice->max_key().compare(min_key) < 0)
+            {
+                continue;
+            }
+
+            if (slice->min_key().compare(max_key) > 0)
+            {
+                continue;
+            }
+
+            slices->push_back(slice);
+        }
+    }
+}
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+
+#include <tyrdbs/slice.h>
+
+#include <unordered_map>
+#include <memory>
+#include <vector>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class compaction_policy
+{
+public:
+    enum class type
+    {
+        tiered,
+        leveled
+    };
+
+public:
+    using slice_ptr =
+            std::shared_ptr<slice>;
+
+    using slices_t =
+            std::vector<slice_ptr>;
+
+    using runs_t =
+            std::vector<slices_t>;
+
+    using levels_t =
+            std::unordered_map<uint32_t, runs_t>;
+
+public:
+    struct task
+    {
+        slices_t slices;
+        uint32_t level{0};
+        bool compact{false};
+        bool rewrite{false};
+    };
+
+public:
+    virtual uint32_t level_of(uint32_t level, const slices_t& run) const = 0;
+    virtual uint32_t ingest_level(const slices_t& run, const levels_t& levels) const = 0;
+    virtual void insert(uint32_t level, slices_t run, levels_t* levels) const = 0;
+
+    virtual bool needs_merge(uint32_t level, const levels_t& levels) const = 0;
+
+    virtual task plan(uint32_t level, const levels_t& levels) = 0;
+    virtual task plan_compaction(const levels_t& levels) const = 0;
+
+    virtual ~compaction_policy() = default;
+
+public:
+    static std::unique_ptr<compaction_policy> create(type policy_type);
+
+    static uint64_t key_count(const slices_t& slices);
+    static uint64_t key_count(const runs_t& runs);
+};
+
+
+class tiered_policy : public compaction_policy
+{
+public:
+    static constexpr uint32_t max_runs_per_tier{4};
+
+public:
+    uint32_t level_of(uint32_t level, const slices_t& run) const override;
+    uint32_t ingest_level(const slices_t& run, const levels_t& levels) const override;
+    void insert(uint32_t level, slices_t run, levels_t* levels) const override;
+
+    bool needs_merge(uint32_t level, const levels_t& levels) const override;
+
+    task plan(uint32_t level, const levels_t& levels) override;
+    task plan_compaction(const levels_t& levels) const override;
+};
+
+
+class leveled_policy : public compaction_policy
+{
+public:
+    static constexpr uint32_t max_level0_runs{4};
+    static constexpr uint64_t base_key_count{1UL << 20};
+    static constexpr uint64_t level_multiplier{10};
+
+public:
+    uint32_t level_of(uint32_t level, const slices_t& run) const override;
+    uint32_t ingest_level(const slices_t& run, const levels_t& levels) const override;
+    void insert(uint32_t level, slices_t run, levels_t* levels) const override;
+
+    bool needs_merge(uint32_t level, const levels_t& levels) const override;
+
+    task plan(uint32_t level, const levels_t& levels) override;
+    task plan_compaction(const levels_t& levels) const override;
+
+private:
+    using cursors_t =
+            std::unordered_map<uint32_t, std::string>;
+
+private:
+    cursors_t m_cursors;
+
+private:
+    slice_ptr next_slice(uint32_t level, const runs_t& runs);
+
+    static uint64_t target_key_count(uint32_t level);
+    static uint32_t last_level(const levels_t& levels);
+
+    static bool overlaps(const runs_t& runs, const slices_t& run);
+
+    static void add_overlapping(const runs_t& runs,
+                                const std::string& min_key,
+                                const std::string& max_key,
+                                slices_t* slices);
+};
+
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+
+#include <common/disallow_copy.h>
+#include <common/exception.h>
+#include <common/branch_prediction.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class gorilla_decoder : private disallow_copy
+{
+public:
+    DEFINE_EXCEPTION(runtime_error, error);
+
+public:
+    uint32_t decode(uint64_t* timestamps, uint64_t* values, uint32_t count)
+    {
+        uint32_t ndx = 0;
+
+        if (count > m_samples - m_ndx)
+        {
+            count = m_samples - m_ndx;
+        }
+
+        if (count != 0 && m_ndx == 0)
+        {
+            m_timestamp = read(64);
+            m_value = read(64);
+
+            timestamps[ndx] = m_timestamp;
+            values[ndx] = m_value;
+
+            ndx++;
+        }
+
+        for (; ndx < count; ndx++)
+        {
+            auto& t = timestamp_codes[peek(4)];
+
+            consume(t.code_size);
+
+            if (t.value_size != 0)
+            {
+                m_delta += read(t.value_size) - t.bias;
+            }
+
+            m_timestamp += m_delta;
+
+            uint64_t v = peek(2);
+
+            if (v < 2)
+            {
+                consume(1);
+
+                m_value_size = 0;
+            }
+            else
+            {
+                consume(2);
+
+                if (v == 3)
+                {
+                    load_value_ctrl(read(9));
+                }
+
+                assert(likely(m_value_size != 0));
+
+                m_value ^= read(m_value_size) << m_ctz;
+            }
+
+            timestamps[ndx] = m_timestamp;
+            values[ndx] = m_value;
+        }
+
+        if (unlikely(m_consumed > m_size))
+        {
+            throw error("no more data in source");
+        }
+
+        m_ndx += count;
+
+        return count;
+    }
+
+    uint32_t samples() const
+    {
+        return m_samples;
+    }
+
+public:
+    gorilla_decoder(uint32_t samples, const char* data, uint32_t size)
+      : m_samples(samples)
+      , m_data(data)
+      , m_end(data + size)
+      , m_size(static_cast<uint64_t>(size / sizeof(uint64_t)) << 6)
+    {
+        m_bits = load();
+        m_next_bits = load();
+    }
+
+private:
+    struct timestamp_code
+    {
+        uint8_t code_size;
+        uint8_t value_size;
+        uint32_t bias;
+    };
+
+    static constexpr timestamp_code timestamp_codes[16] = {
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+        {2, 7, 0x3f},
+        {2, 7, 0x3f},
+        {2, 7, 0x3f},
+        {2, 7, 0x3f},
+        {3, 9, 0xff},
+        {3, 9, 0xff},
+        {4, 12, 0x7ff},
+        {4, 32, 0x7fffffffU}
+    };
+
+private:
+    uint32_t m_samples{0};
+    uint32_t m_ndx{0};
+
+    uint64_t m_timestamp{0};
+    uint64_t m_delta{0};
+
+    uint64_t m_value{0};
+    uint32_t m_value_size{0};
+    uint32_t m_ctz{0};
+
+    const char* m_data{nullptr};
+    const char* m_end{nullptr};
+
+    uint64_t m_bits{0};
+    uint64_t m_next_bits{0};
+    uint32_t m_offset{0};
+
+    uint64_t m_size{0};
+    uint64_t m_consumed{0};
+
+private:
+    uint64_t load()
+    {
+        uint64_t bits = 0;
+
+        if (m_data + sizeof(bits) <= m_end)
+        {
+            std::memcpy(&bits, m_data, sizeof(bits));
+            m_data += sizeof(bits);
+        }
+
+        return bits;
+    }
+
+    uint64_t window() const
+    {
+        if (m_offset == 0)
+        {
+            return m_bits;
+        }
+
+        return (m_bits << m_offset) | (m_next_bits >> (64 - m_offset));
+    }
+
+    uint64_t peek(uint32_t bits) const
+    {
+        assert(likely(bits != 0 && bits <= 64));
+        return window() >> (64 - bits);
+    }
+
+    void consume(uint32_t bits)
+    {
+        m_offset += bits;
+        m_consumed += bits;
+
+        if (m_offset < 64)
+        {
+            return;
+        }
+
+        m_bits = m_next_bits;
+        m_next_bits = load();
+
+        m_offset -= 64;
+    }
+
+    uint64_t read(uint32_t bits)
+    {
+        uint64_t value = peek(bits);
+        consume(bits);
+
+        return value;
+    }
+
+    void load_value_ctrl(uint64_t value_ctrl)
+    {
+        uint32_t size = value_ctrl & 0x1f;
+        uint32_t clz = (value_ctrl >> 5) & 0x0f;
+
+        m_value_size = size << 2;
+        m_ctz = (16 - (clz + size)) << 2;
+    }
+};
+
+}
@@ -169,7 +169,7 @@ private:
         }
         else
         {
-            assert((value & ~(0xffffffffU)) == 0);
+            assert(likely(value >= -0x7fffffffL && value <= 0x80000000L));
 
             value += 0x7fffffffU;
             value &= 0xffffffffU;
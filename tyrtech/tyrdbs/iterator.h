@@ -12,12 +12,15 @@ namespace tyrtech::tyrdbs {
 struct iterator : private disallow_copy, disallow_move
 {
     virtual bool next() = 0;
+    virtual bool seek(const std::string_view& key) = 0;
 
     virtual std::string_view key() const = 0;
     virtual std::string_view value() const = 0;
     virtual bool eor() const = 0;
     virtual bool deleted() const = 0;
+    virtual bool indirect() const = 0;
     virtual uint64_t idx() const = 0;
+    virtual uint32_t expires() const = 0;
 
     virtual ~iterator() = default;
 };
@@ -31,4 +31,18 @@ void key_buffer::assign(const std::string_view& other)
     m_size = other.size();
 }
 
+void key_buffer::append(const std::string_view& other)
+{
+    assert(likely(m_size + other.size() <= m_data.size()));
+
+    std::memcpy(m_data.data() + m_size, other.data(), other.size());
+    m_size += other.size();
+}
+
+void key_buffer::resize(uint32_t size)
+{
+    assert(likely(size <= m_size));
+    m_size = size;
+}
+
 }
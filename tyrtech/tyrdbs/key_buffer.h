@@ -15,6 +15,8 @@ public:
 
     void clear();
     void assign(const std::string_view& other);
+    void append(const std::string_view& other);
+    void resize(uint32_t size);
 
 public:
     key_buffer() noexcept = default;
@@ -0,0 +1,562 @@
+#include <common/branch_prediction.h>
+#include <tyrdbs/manifest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class record_writer
+{
+public:
+    template<typename T>
+    void write(const T& value)
+    {
+        m_data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(const std::string_view& value)
+    {
+        write(static_cast<uint16_t>(value.size()));
+        m_data.append(value.data(), value.size());
+    }
+
+    std::string&& data()
+    {
+        return std::move(m_data);
+    }
+
+private:
+    std::string m_data;
+};
+
+
+class record_reader
+{
+public:
+    template<typename T>
+    T read()
+    {
+        T value;
+
+        std::memcpy(&value, consume(sizeof(T)), sizeof(T));
+
+        return value;
+    }
+
+    std::string_view read_string()
+    {
+        uint16_t size = read<uint16_t>();
+        return std::string_view(consume(size), size);
+    }
+
+    bool empty() const
+    {
+        return m_data.size() == 0;
+    }
+
+public:
+    record_reader(const std::string_view& data)
+      : m_data(data)
+    {
+    }
+
+private:
+    std::string_view m_data;
+
+private:
+    const char* consume(uint32_t size)
+    {
+        if (m_data.size() < size)
+        {
+            throw manifest::error("invalid manifest record");
+        }
+
+        const char* data = m_data.data();
+        m_data.remove_prefix(size);
+
+        return data;
+    }
+};
+
+
+void manifest::add(const std::string_view& collection,
+                   uint32_t ushard_id,
+                   uint32_t level,
+                   const ushard::slices_t& slices)
+{
+    ushard_key_t key(collection, ushard_id);
+    descriptors_t descriptors;
+
+    descriptors.reserve(slices.size());
+
+    for (auto&& slice : slices)
+    {
+        descriptors.push_back(slice->descriptor());
+    }
+
+    auto&& record = add_record(key, level, descriptors);
+
+    apply_add(key, level, std::move(descriptors));
+    append(record);
+}
+
+void manifest::remove(const std::string_view& collection,
+                      uint32_t ushard_id,
+                      const ushard::slices_t& slices)
+{
+    ushard_key_t key(collection, ushard_id);
+    slice_ids_t ids;
+
+    ids.reserve(slices.size());
+
+    for (auto&& slice : slices)
+    {
+        ids.push_back(id_of(slice->descriptor()));
+    }
+
+    apply_remove(key, ids);
+    append(remove_record(key, ids));
+}
+
+void manifest::add_segment(const std::string_view& collection,
+                           uint32_t ushard_id,
+                           const value_log::segment_ptr& segment)
+{
+    ushard_key_t key(collection, ushard_id);
+
+    auto&& record = add_segment_record(key, segment->id(), segment->descriptor());
+
+    m_segments[key][segment->id()] = segment->descriptor();
+    append(record);
+}
+
+void manifest::remove_segments(const std::string_view& collection,
+                               uint32_t ushard_id,
+                               const value_log::segments_t& segments)
+{
+    ushard_key_t key(collection, ushard_id);
+    value_log::segment_ids_t ids;
+
+    ids.reserve(segments.size());
+
+    for (auto&& segment : segments)
+    {
+        ids.push_back(segment->id());
+    }
+
+    apply_remove_segments(key, ids);
+    append(remove_segments_record(key, ids));
+}
+
+void manifest::drop(const std::string_view& collection, uint32_t ushard_id)
+{
+    ushard_key_t key(collection, ushard_id);
+
+    m_ushards.erase(key);
+    m_segments.erase(key);
+    append(drop_record(key));
+}
+
+manifest::ushard_ids_t manifest::ushard_ids(const std::string_view& collection) const
+{
+    ushard_ids_t ids;
+
+    for (auto&& it : m_ushards)
+    {
+        if (it.first.first.compare(collection) == 0)
+        {
+            ids.push_back(it.first.second);
+        }
+    }
+
+    for (auto&& it : m_segments)
+    {
+        if (it.first.first.compare(collection) != 0)
+        {
+            continue;
+        }
+
+        if (m_ushards.find(it.first) == m_ushards.end())
+        {
+            ids.push_back(it.first.second);
+        }
+    }
+
+    return ids;
+}
+
+void manifest::restore(const std::string_view& collection, uint32_t ushard_id, ushard* ushard)
+{
+    ushard_key_t key(collection, ushard_id);
+
+    if (auto it = m_segments.find(key); it != m_segments.end())
+    {
+        for (auto&& segment : it->second)
+        {
+            storage::file_descriptor d = segment.second;
+            d.cache_id = storage::new_cache_id();
+
+            ushard->restore(std::make_shared<value_log::segment>(segment.first,
+                                                                 storage::create_reader(std::move(d))));
+        }
+    }
+
+    auto it = m_ushards.find(key);
+
+    if (it == m_ushards.end())
+    {
+        return;
+    }
+
+    for (auto&& r : it->second)
+    {
+        ushard::slices_t run;
+        run.reserve(r.descriptors.size());
+
+        for (auto&& descriptor : r.descriptors)
+        {
+            storage::file_descriptor d = descriptor;
+            d.cache_id = storage::new_cache_id();
+
+            run.push_back(std::make_shared<slice>(storage::create_reader(std::move(d))));
+        }
+
+        ushard->restore(r.level, std::move(run));
+    }
+}
+
+manifest::manifest()
+{
+    for (auto&& record : storage::load_metadata())
+    {
+        apply(record);
+    }
+
+    for (auto&& it : m_ushards)
+    {
+        for (auto&& run : it.second)
+        {
+            for (auto&& descriptor : run.descriptors)
+            {
+                storage::reserve(descriptor.extents);
+            }
+        }
+    }
+
+    for (auto&& it : m_segments)
+    {
+        for (auto&& segment : it.second)
+        {
+            storage::reserve(segment.second.extents);
+        }
+    }
+
+    m_rewrite_pages = std::max(min_rewrite_pages, storage::metadata_size() << 1);
+}
+
+void manifest::apply(const std::string_view& record)
+{
+    record_reader reader(record);
+
+    auto type = static_cast<edit>(reader.read<uint8_t>());
+
+    std::string_view collection = reader.read_string();
+    uint32_t ushard_id = reader.read<uint32_t>();
+
+    ushard_key_t key(collection, ushard_id);
+
+    switch (type)
+    {
+        case edit::add:
+        {
+            uint32_t level = reader.read<uint32_t>();
+            descriptors_t descriptors(reader.read<uint32_t>());
+
+            for (auto&& descriptor : descriptors)
+            {
+                descriptor.size = reader.read<uint64_t>();
+                descriptor.extents.resize(reader.read<uint32_t>());
+
+                for (auto&& extent : descriptor.extents)
+                {
+                    extent = reader.read<uint64_t>();
+                }
+            }
+
+            apply_add(key, level, std::move(descriptors));
+
+            break;
+        }
+        case edit::remove:
+        {
+            slice_ids_t ids(reader.read<uint32_t>());
+
+            for (auto&& id : ids)
+            {
+                id = reader.read<uint32_t>();
+            }
+
+            apply_remove(key, ids);
+
+            break;
+        }
+        case edit::drop:
+        {
+            m_ushards.erase(key);
+            m_segments.erase(key);
+
+            break;
+        }
+        case edit::add_segment:
+        {
+            uint64_t id = reader.read<uint64_t>();
+
+            storage::file_descriptor descriptor;
+
+            descriptor.size = reader.read<uint64_t>();
+            descriptor.extents.resize(reader.read<uint32_t>());
+
+            for (auto&& extent : descriptor.extents)
+            {
+                extent = reader.read<uint64_t>();
+            }
+
+            m_segments[key][id] = std::move(descriptor);
+
+            break;
+        }
+        case edit::remove_segments:
+        {
+            value_log::segment_ids_t ids(reader.read<uint32_t>());
+
+            for (auto&& id : ids)
+            {
+                id = reader.read<uint64_t>();
+            }
+
+            apply_remove_segments(key, ids);
+
+            break;
+        }
+        default:
+        {
+            throw error("invalid manifest record");
+        }
+    }
+
+    if (reader.empty() == false)
+    {
+        throw error("invalid manifest record");
+    }
+}
+
+void manifest::apply_add(const ushard_key_t& key, uint32_t level, descriptors_t&& descriptors)
+{
+    if (descriptors.size() == 0)
+    {
+        return;
+    }
+
+    slice_ids_t ids;
+    ids.reserve(descriptors.size());
+
+    for (auto&& descriptor : descriptors)
+    {
+        ids.push_back(id_of(descriptor));
+    }
+
+    apply_remove(key, ids);
+
+    m_ushards[key].push_back(run{level, std::move(descriptors)});
+}
+
+void manifest::apply_remove(const ushard_key_t& key, const slice_ids_t& ids)
+{
+    auto it = m_ushards.find(key);
+
+    if (it == m_ushards.end())
+    {
+        return;
+    }
+
+    auto&& is_removed = [&ids](const storage::file_descriptor& descriptor)
+    {
+        return std::find(ids.begin(), ids.end(), id_of(descriptor)) != ids.end();
+    };
+
+    for (auto&& run : it->second)
+    {
+        run.descriptors.erase(std::remove_if(run.descriptors.begin(),
+                                             run.descriptors.end(),
+                                             is_removed),
+                              run.descriptors.end());
+    }
+
+    auto&& is_empty = [](const manifest::run& run)
+    {
+        return run.descriptors.size() == 0;
+    };
+
+    it->second.erase(std::remove_if(it->second.begin(), it->second.end(), is_empty),
+                     it->second.end());
+}
+
+void manifest::apply_remove_segments(const ushard_key_t& key, const value_log::segment_ids_t& ids)
+{
+    auto it = m_segments.find(key);
+
+    if (it == m_segments.end())
+    {
+        return;
+    }
+
+    for (auto&& id : ids)
+    {
+        it->second.erase(id);
+    }
+
+    if (it->second.size() == 0)
+    {
+        m_segments.erase(it);
+    }
+}
+
+void manifest::append(const std::string& record)
+{
+    storage::append_metadata(record);
+
+    if (storage::metadata_size() < m_rewrite_pages || m_rewrite_active == true)
+    {
+        return;
+    }
+
+    m_rewrite_active = true;
+
+    storage::metadata_log::records_t records;
+
+    for (auto&& it : m_ushards)
+    {
+        for (auto&& run : it.second)
+        {
+            records.push_back(add_record(it.first, run.level, run.descriptors));
+        }
+    }
+
+    for (auto&& it : m_segments)
+    {
+        for (auto&& segment : it.second)
+        {
+            records.push_back(add_segment_record(it.first, segment.first, segment.second));
+        }
+    }
+
+    storage::rewrite_metadata(records);
+
+    m_rewrite_pages = std::max(min_rewrite_pages, storage::metadata_size() << 1);
+    m_rewrite_active = false;
+}
+
+std::string manifest::add_record(const ushard_key_t& key,
+                                 uint32_t level,
+                                 const descriptors_t& descriptors)
+{
+    record_writer writer;
+
+    writer.write(static_cast<uint8_t>(edit::add));
+    writer.write(std::string_view(key.first));
+    writer.write(key.second);
+    writer.write(level);
+    writer.write(static_cast<uint32_t>(descriptors.size()));
+
+    for (auto&& descriptor : descriptors)
+    {
+        writer.write(descriptor.size);
+        writer.write(static_cast<uint32_t>(descriptor.extents.size()));
+
+        for (auto&& extent : descriptor.extents)
+        {
+            writer.write(extent);
+        }
+    }
+
+    return writer.data();
+}
+
+std::string manifest::remove_record(const ushard_key_t& key, const slice_ids_t& ids)
+{
+    record_writer writer;
+
+    writer.write(static_cast<uint8_t>(edit::remove));
+    writer.write(std::string_view(key.first));
+    writer.write(key.second);
+    writer.write(static_cast<uint32_t>(ids.size()));
+
+    for (auto&& id : ids)
+    {
+        writer.write(id);
+    }
+
+    return writer.data();
+}
+
+std::string manifest::drop_record(const ushard_key_t& key)
+{
+    record_writer writer;
+
+    writer.write(static_cast<uint8_t>(edit::drop));
+    writer.write(std::string_view(key.first));
+    writer.write(key.second);
+
+    return writer.data();
+}
+
+std::string manifest::add_segment_record(const ushard_key_t& key,
+                                         uint64_t id,
+                                         const storage::file_descriptor& descriptor)
+{
+    record_writer writer;
+
+    writer.write(static_cast<uint8_t>(edit::add_segment));
+    writer.write(std::string_view(key.first));
+    writer.write(key.second);
+    writer.write(id);
+    writer.write(descriptor.size);
+    writer.write(static_cast<uint32_t>(descriptor.extents.size()));
+
+    for (auto&& extent : descriptor.extents)
+    {
+        writer.write(extent);
+    }
+
+    return writer.data();
+}
+
+std::string manifest::remove_segments_record(const ushard_key_t& key,
+                                             const value_log::segment_ids_t& ids)
+{
+    record_writer writer;
+
+    writer.write(static_cast<uint8_t>(edit::remove_segments));
+    writer.write(std::string_view(key.first));
+    writer.write(key.second);
+    writer.write(static_cast<uint32_t>(ids.size()));
+
+    for (auto&& id : ids)
+    {
+        writer.write(id);
+    }
+
+    return writer.data();
+}
+
+uint32_t manifest::id_of(const storage::file_descriptor& descriptor)
+{
+    assert(likely(descriptor.extents.size() != 0));
+    return descriptor.extents.front() >> 32;
+}
+
+}
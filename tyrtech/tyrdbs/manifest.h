@@ -0,0 +1,118 @@
+#pragma once
+
+
+#include <tyrdbs/ushard.h>
+
+#include <map>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class manifest : private disallow_copy, disallow_move
+{
+public:
+    DEFINE_EXCEPTION(runtime_error, error);
+
+public:
+    static constexpr uint32_t min_rewrite_pages{64};
+
+public:
+    using ushard_ids_t =
+            std::vector<uint32_t>;
+
+public:
+    void add(const std::string_view& collection,
+             uint32_t ushard_id,
+             uint32_t level,
+             const ushard::slices_t& slices);
+
+    void remove(const std::string_view& collection,
+                uint32_t ushard_id,
+                const ushard::slices_t& slices);
+
+    void add_segment(const std::string_view& collection,
+                     uint32_t ushard_id,
+                     const value_log::segment_ptr& segment);
+
+    void remove_segments(const std::string_view& collection,
+                         uint32_t ushard_id,
+                         const value_log::segments_t& segments);
+
+    void drop(const std::string_view& collection, uint32_t ushard_id);
+
+    ushard_ids_t ushard_ids(const std::string_view& collection) const;
+    void restore(const std::string_view& collection, uint32_t ushard_id, ushard* ushard);
+
+public:
+    manifest();
+
+private:
+    enum class edit : uint8_t
+    {
+        add = 1,
+        remove = 2,
+        drop = 3,
+        add_segment = 4,
+        remove_segments = 5
+    };
+
+private:
+    using descriptors_t =
+            std::vector<storage::file_descriptor>;
+
+    struct run
+    {
+        uint32_t level{0};
+        descriptors_t descriptors;
+    };
+
+    using runs_t =
+            std::vector<run>;
+
+    using ushard_key_t =
+            std::pair<std::string, uint32_t>;
+
+    using ushards_t =
+            std::map<ushard_key_t, runs_t>;
+
+    using slice_ids_t =
+            std::vector<uint32_t>;
+
+    using segment_descriptors_t =
+            std::map<uint64_t, storage::file_descriptor>;
+
+    using segments_t =
+            std::map<ushard_key_t, segment_descriptors_t>;
+
+private:
+    ushards_t m_ushards;
+    segments_t m_segments;
+
+    uint32_t m_rewrite_pages{min_rewrite_pages};
+    bool m_rewrite_active{false};
+
+private:
+    void apply(const std::string_view& record);
+
+    void apply_add(const ushard_key_t& key, uint32_t level, descriptors_t&& descriptors);
+    void apply_remove(const ushard_key_t& key, const slice_ids_t& ids);
+    void apply_remove_segments(const ushard_key_t& key, const value_log::segment_ids_t& ids);
+
+    void append(const std::string& record);
+
+    static std::string add_record(const ushard_key_t& key,
+                                  uint32_t level,
+                                  const descriptors_t& descriptors);
+    static std::string remove_record(const ushard_key_t& key, const slice_ids_t& ids);
+    static std::string drop_record(const ushard_key_t& key);
+    static std::string add_segment_record(const ushard_key_t& key,
+                                          uint64_t id,
+                                          const storage::file_descriptor& descriptor);
+    static std::string remove_segments_record(const ushard_key_t& key,
+                                              const value_log::segment_ids_t& ids);
+
+    static uint32_t id_of(const storage::file_descriptor& descriptor);
+};
+
+}
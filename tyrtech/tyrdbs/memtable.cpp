@@ -0,0 +1,287 @@
+#include <common/branch_prediction.h>
+#include <tyrdbs/memtable.h>
+
+#include <cstring>
+#include <cassert>
+#include <new>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class memtable_iterator : public iterator
+{
+public:
+    bool next() override;
+    bool seek(const std::string_view& key) override;
+
+    std::string_view key() const override;
+    std::string_view value() const override;
+    bool eor() const override;
+    bool deleted() const override;
+    bool indirect() const override;
+    uint64_t idx() const override;
+    uint32_t expires() const override;
+
+public:
+    memtable_iterator(std::shared_ptr<memtable> memtable, const memtable::entry* entry);
+
+private:
+    std::shared_ptr<memtable> m_memtable;
+
+    const memtable::entry* m_next{nullptr};
+    const memtable::entry* m_entry{nullptr};
+
+    uint64_t m_snapshot{0};
+};
+
+bool memtable_iterator::next()
+{
+    if (m_entry != nullptr)
+    {
+        m_next = m_entry->next()[0];
+    }
+
+    while (m_next != nullptr && m_next->seq > m_snapshot)
+    {
+        m_next = m_next->next()[0];
+    }
+
+    m_entry = m_next;
+
+    return m_entry != nullptr;
+}
+
+bool memtable_iterator::seek(const std::string_view& key)
+{
+    auto current = m_entry != nullptr ? m_entry : m_next;
+
+    if (current == nullptr || current->key().compare(key) >= 0)
+    {
+        return next();
+    }
+
+    m_entry = nullptr;
+    m_next = m_memtable->lower_bound(key);
+
+    return next();
+}
+
+std::string_view memtable_iterator::key() const
+{
+    return m_entry->key();
+}
+
+std::string_view memtable_iterator::value() const
+{
+    return m_entry->value();
+}
+
+bool memtable_iterator::eor() const
+{
+    return (m_entry->flags & 0x01) != 0;
+}
+
+bool memtable_iterator::deleted() const
+{
+    return (m_entry->flags & 0x02) != 0;
+}
+
+bool memtable_iterator::indirect() const
+{
+    return false;
+}
+
+uint64_t memtable_iterator::idx() const
+{
+    return m_entry->idx;
+}
+
+uint32_t memtable_iterator::expires() const
+{
+    return m_entry->expires;
+}
+
+memtable_iterator::memtable_iterator(std::shared_ptr<memtable> memtable,
+                                     const memtable::entry* entry)
+  : m_memtable(std::move(memtable))
+  , m_next(entry)
+  , m_snapshot(m_memtable->m_seq)
+{
+}
+
+void memtable::add(const std::string_view& key,
+                   const std::string_view& value,
+                   bool eor,
+                   bool deleted,
+                   uint64_t idx,
+                   uint32_t expires)
+{
+    uint64_t seq = ++m_seq;
+
+    entry* update[max_height];
+    entry* e = m_head;
+
+    for (int32_t level = max_height - 1; level >= 0; level--)
+    {
+        while (e->next()[level] != nullptr && precedes(e->next()[level], key, idx, seq) == true)
+        {
+            e = e->next()[level];
+        }
+
+        update[level] = e;
+    }
+
+    entry* new_entry = allocate(key, value, random_height());
+
+    new_entry->idx = idx;
+    new_entry->seq = seq;
+    new_entry->expires = expires;
+    new_entry->flags = (eor ? 0x01 : 0) | (deleted ? 0x02 : 0);
+
+    for (uint32_t level = 0; level < new_entry->height; level++)
+    {
+        new_entry->next()[level] = update[level]->next()[level];
+        update[level]->next()[level] = new_entry;
+    }
+}
+
+std::unique_ptr<iterator> memtable::range(const std::string_view& min_key)
+{
+    return std::make_unique<memtable_iterator>(shared_from_this(), lower_bound(min_key));
+}
+
+std::unique_ptr<iterator> memtable::begin()
+{
+    return std::make_unique<memtable_iterator>(shared_from_this(), m_head->next()[0]);
+}
+
+uint64_t memtable::size() const
+{
+    return m_size;
+}
+
+memtable::memtable()
+{
+    m_head = allocate(std::string_view(), std::string_view(), max_height);
+    m_size = 0;
+}
+
+memtable::entry** memtable::entry::next()
+{
+    return reinterpret_cast<entry**>(this + 1);
+}
+
+memtable::entry* const* memtable::entry::next() const
+{
+    return reinterpret_cast<entry* const*>(this + 1);
+}
+
+std::string_view memtable::entry::key() const
+{
+    return std::string_view(reinterpret_cast<const char*>(next() + height), key_size);
+}
+
+std::string_view memtable::entry::value() const
+{
+    return std::string_view(reinterpret_cast<const char*>(next() + height) + key_size, value_size);
+}
+
+memtable::entry* memtable::allocate(const std::string_view& key,
+                                    const std::string_view& value,
+                                    uint8_t height)
+{
+    uint32_t size = sizeof(entry) + height * sizeof(entry*) + key.size() + value.size();
+
+    auto e = new (allocate(size)) entry();
+
+    e->value_size = value.size();
+    e->key_size = key.size();
+    e->height = height;
+
+    std::memset(e->next(), 0, height * sizeof(entry*));
+
+    char* data = reinterpret_cast<char*>(e->next() + height);
+
+    std::memcpy(data, key.data(), key.size());
+    std::memcpy(data + key.size(), value.data(), value.size());
+
+    return e;
+}
+
+char* memtable::allocate(uint32_t size)
+{
+    size = (size + 7) & ~7U;
+    m_size += size;
+
+    if (size > block_size / 4)
+    {
+        m_blocks.emplace_back(new char[size]);
+        return m_blocks.back().get();
+    }
+
+    if (m_block == nullptr || m_block_offset + size > block_size)
+    {
+        m_blocks.emplace_back(new char[block_size]);
+
+        m_block = m_blocks.back().get();
+        m_block_offset = 0;
+    }
+
+    char* data = m_block + m_block_offset;
+    m_block_offset += size;
+
+    return data;
+}
+
+uint8_t memtable::random_height()
+{
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 7;
+    m_random ^= m_random << 17;
+
+    uint64_t random = m_random;
+    uint8_t height = 1;
+
+    while (height < max_height && (random & 0x03) == 0)
+    {
+        random >>= 2;
+        height++;
+    }
+
+    return height;
+}
+
+const memtable::entry* memtable::lower_bound(const std::string_view& key) const
+{
+    const entry* e = m_head;
+
+    for (int32_t level = max_height - 1; level >= 0; level--)
+    {
+        while (e->next()[level] != nullptr && e->next()[level]->key().compare(key) < 0)
+        {
+            e = e->next()[level];
+        }
+    }
+
+    return e->next()[0];
+}
+
+bool memtable::precedes(const entry* e, const std::string_view& key, uint64_t idx, uint64_t seq)
+{
+    int32_t cmp = e->key().compare(key);
+
+    if (cmp != 0)
+    {
+        return cmp < 0;
+    }
+
+    if (e->idx != idx)
+    {
+        return e->idx > idx;
+    }
+
+    return e->seq < seq;
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+
+#include <common/disallow_copy.h>
+#include <common/disallow_move.h>
+#include <tyrdbs/iterator.h>
+
+#include <memory>
+#include <vector>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class memtable : private disallow_copy, disallow_move, public std::enable_shared_from_this<memtable>
+{
+public:
+    static constexpr uint32_t max_height{12};
+    static constexpr uint32_t block_size{1U << 20};
+
+public:
+    void add(const std::string_view& key,
+             const std::string_view& value,
+             bool eor,
+             bool deleted,
+             uint64_t idx,
+             uint32_t expires);
+
+    std::unique_ptr<iterator> range(const std::string_view& min_key);
+    std::unique_ptr<iterator> begin();
+
+    uint64_t size() const;
+
+public:
+    memtable();
+
+private:
+    struct entry
+    {
+        uint64_t idx{0};
+        uint64_t seq{0};
+        uint32_t expires{0};
+        uint32_t value_size{0};
+        uint16_t key_size{0};
+        uint8_t flags{0};
+        uint8_t height{0};
+
+        entry** next();
+        entry* const* next() const;
+
+        std::string_view key() const;
+        std::string_view value() const;
+    };
+
+    using blocks_t =
+            std::vector<std::unique_ptr<char[]>>;
+
+private:
+    blocks_t m_blocks;
+
+    char* m_block{nullptr};
+    uint32_t m_block_offset{0};
+
+    uint64_t m_size{0};
+
+    entry* m_head{nullptr};
+
+    uint64_t m_seq{0};
+    uint64_t m_random{0x9e3779b97f4a7c15UL};
+
+private:
+    entry* allocate(const std::string_view& key, const std::string_view& value, uint8_t height);
+    char* allocate(uint32_t size);
+
+    uint8_t random_height();
+
+    const entry* lower_bound(const std::string_view& key) const;
+
+    static bool precedes(const entry* e, const std::string_view& key, uint64_t idx, uint64_t seq);
+
+private:
+    friend class memtable_iterator;
+};
+
+}
@@ -1,8 +1,11 @@
 #include <common/branch_prediction.h>
 #include <common/exception.h>
 #include <tyrdbs/node.h>
+#include <tyrdbs/key_buffer.h>
 
 #include <lz4.h>
+#include <algorithm>
+#include <cstring>
 #include <cassert>
 
 
@@ -23,7 +26,17 @@ void node::load(const char* source, uint32_t source_size)
         throw runtime_error("unable to decompress node");
     }
 
-    m_key_count = *reinterpret_cast<const uint16_t*>(m_data.data());
+    auto h = reinterpret_cast<const header*>(m_data.data());
+
+    if (h->format != format || h->restart_interval == 0)
+    {
+        throw runtime_error("unsupported node format");
+    }
+
+    m_key_count = h->key_count;
+    m_restart_interval = h->restart_interval;
+
+    load_prefixes();
 }
 
 uint64_t node::get_next() const
@@ -42,11 +55,50 @@ uint16_t node::key_count() const
     return m_key_count;
 }
 
-std::string_view node::key_at(uint16_t ndx) const
+std::string_view node::key_at(uint16_t ndx, key_buffer* buffer) const
 {
+    assert(likely(ndx < m_key_count));
+
+    uint16_t restart = ndx - ndx % m_restart_interval;
+    std::string_view key;
+
+    for (uint16_t key_ndx = restart; key_ndx <= ndx; key_ndx++)
+    {
+        key = next_key_at(key_ndx, key, buffer);
+    }
+
+    return key;
+}
+
+std::string_view node::next_key_at(uint16_t ndx,
+                                   const std::string_view& key,
+                                   key_buffer* buffer) const
+{
+    assert(likely(ndx < m_key_count));
+
     const entry* entry = entry_at(ndx);
+    const char* suffix = m_data.data() + entry->key_offset;
+
+    if (entry->shared_size == 0)
+    {
+        return std::string_view(suffix, entry->key_size);
+    }
+
+    assert(likely(ndx % m_restart_interval != 0));
+    assert(likely(entry->shared_size <= key.size()));
 
-    return std::string_view(m_data.data() + entry->key_offset, entry->key_size);
+    if (key.data() == buffer->data().data())
+    {
+        buffer->resize(entry->shared_size);
+    }
+    else
+    {
+        buffer->assign(key.substr(0, entry->shared_size));
+    }
+
+    buffer->append(std::string_view(suffix, entry->key_size));
+
+    return buffer->data();
 }
 
 std::string_view node::value_at(uint16_t ndx) const
@@ -69,47 +121,161 @@ bool node::deleted_at(uint16_t ndx) const
     return entry_at(ndx)->deleted;
 }
 
+bool node::indirect_at(uint16_t ndx) const
+{
+    return entry_at(ndx)->indirect;
+}
+
 uint16_t node::lower_bound(const std::string_view& key) const
 {
-    uint16_t start = 0;
-    uint16_t end = key_count();
+    if (unlikely(m_key_count == 0))
+    {
+        return 0;
+    }
+
+    key_buffer buffer;
+    auto&& first_key = key_at(0, &buffer);
+
+    if (key.compare(0, m_prefix_offset, first_key, 0, m_prefix_offset) != 0)
+    {
+        if (key.compare(first_key) <= 0)
+        {
+            return 0;
+        }
+
+        return m_key_count;
+    }
 
-    while (end - start > 8)
+    uint64_t prefix = prefix_of(key, m_prefix_offset);
+
+    uint16_t start = prefix_bound(prefix, false);
+
+    if (start == m_key_count || m_prefixes[start] != prefix)
     {
-        uint16_t ndx = ((end - start) >> 1) + start;
+        return start;
+    }
+
+    uint16_t end = prefix_bound(prefix, true);
+
+    uint16_t first = (start + m_restart_interval - 1) / m_restart_interval;
+    uint16_t last = (end + m_restart_interval - 1) / m_restart_interval;
 
-        int32_t cmp = key.compare(key_at(ndx));
+    while (first < last)
+    {
+        uint16_t restart = ((last - first) >> 1) + first;
 
-        if (cmp <= 0)
+        if (key.compare(key_at(restart * m_restart_interval, &buffer)) <= 0)
         {
-            end = ndx;
+            last = restart;
         }
         else
         {
-            start = ndx;
+            first = restart + 1;
         }
     }
 
-    for (uint16_t ndx = start; ndx < end; ndx++)
+    uint16_t ndx = first * m_restart_interval;
+
+    end = std::min(ndx, end);
+    ndx = ndx >= start + m_restart_interval ? ndx - m_restart_interval : start;
+
+    if (ndx == end)
     {
-        if (key.compare(key_at(ndx)) <= 0)
+        return end;
+    }
+
+    std::string_view ndx_key = key_at(ndx, &buffer);
+
+    while (key.compare(ndx_key) > 0)
+    {
+        if (++ndx == end)
         {
-            return ndx;
+            break;
         }
+
+        ndx_key = next_key_at(ndx, ndx_key, &buffer);
     }
 
-    return end;
+    return ndx;
+}
+
+uint16_t node::prefix_bound(uint64_t prefix, bool upper) const
+{
+    const uint64_t* data = m_prefixes.data();
+    const uint64_t* base = data;
+
+    uint32_t size = m_key_count;
+
+    while (size > 1)
+    {
+        uint32_t half = size >> 1;
+
+        bool skip = base[half] < prefix || (upper == true && base[half] == prefix);
+        base += skip * half;
+
+        size -= half;
+    }
+
+    bool skip = *base < prefix || (upper == true && *base == prefix);
+
+    return (base - data) + skip;
+}
+
+uint64_t node::prefix_of(const std::string_view& key, uint16_t offset)
+{
+    uint64_t prefix = 0;
+
+    if (key.size() > offset)
+    {
+        std::memcpy(&prefix,
+                    key.data() + offset,
+                    std::min(key.size() - offset, sizeof(prefix)));
+    }
+
+    return __builtin_bswap64(prefix);
 }
 
 const node::entry* node::entry_at(uint16_t ndx) const
 {
     const char* data = m_data.data();
 
-    data += sizeof(m_key_count);
-    data += ndx << 1;
-    data += ndx << 2;
+    data += sizeof(header);
+    data += ndx << 3;
 
     return reinterpret_cast<const entry*>(data);
 }
 
+void node::load_prefixes()
+{
+    m_prefixes.clear();
+    m_prefix_offset = 0;
+
+    if (m_key_count == 0)
+    {
+        return;
+    }
+
+    key_buffer buffer;
+
+    auto&& first_key = key_at(0, &buffer);
+    auto&& last_key = key_at(m_key_count - 1, &buffer);
+
+    uint16_t size = std::min(first_key.size(), last_key.size());
+
+    auto&& res = std::mismatch(first_key.begin(),
+                               first_key.begin() + size,
+                               last_key.begin());
+
+    m_prefix_offset = res.first - first_key.begin();
+    m_prefixes.reserve(m_key_count);
+
+    std::string_view key;
+
+    for (uint16_t ndx = 0; ndx < m_key_count; ndx++)
+    {
+        key = next_key_at(ndx, key, &buffer);
+        m_prefixes.push_back(prefix_of(key, m_prefix_offset));
+    }
+}
+
 }
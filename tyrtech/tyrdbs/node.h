@@ -6,17 +6,23 @@
 
 #include <string>
 #include <array>
+#include <vector>
 
 
 namespace tyrtech::tyrdbs {
 
 
+class key_buffer;
+
+
 class node : private disallow_copy, disallow_move
 {
 public:
     static constexpr uint32_t page_size{8192};
     static constexpr uint32_t node_size{(page_size - 32) * 255 / 256};
     static constexpr uint32_t max_key_size{1024};
+    static constexpr uint8_t format{1};
+    static constexpr uint8_t restart_interval{16};
 
 public:
     void load(const char* source, uint32_t source_size);
@@ -38,39 +44,67 @@ public:
         return reinterpret_cast<const Attributes*>(m_data.data() + offset);
     }
 
-    std::string_view key_at(uint16_t ndx) const;
+    std::string_view key_at(uint16_t ndx, key_buffer* buffer) const;
+    std::string_view next_key_at(uint16_t ndx,
+                                 const std::string_view& key,
+                                 key_buffer* buffer) const;
     std::string_view value_at(uint16_t ndx) const;
     bool eor_at(uint16_t ndx) const;
     bool deleted_at(uint16_t ndx) const;
+    bool indirect_at(uint16_t ndx) const;
 
     uint16_t lower_bound(const std::string_view& key) const;
 
 private:
+    struct header
+    {
+        uint16_t key_count;
+        uint8_t format;
+        uint8_t restart_interval;
+    } __attribute__ ((packed));
+
     struct entry
     {
         uint16_t value_size;
         uint16_t key_offset;
-        uint16_t key_size : 10;
-        uint16_t eor      :  1;
-        uint16_t deleted  :  1;
-        uint16_t reserved :  4;
+        uint16_t key_size    : 10;
+        uint16_t eor         :  1;
+        uint16_t deleted     :  1;
+        uint16_t indirect    :  1;
+        uint16_t reserved    :  3;
+        uint16_t shared_size : 10;
+        uint16_t reserved2   :  6;
     } __attribute__ ((packed));
 
 private:
     using data_t =
             std::array<char, node_size>;
 
+    using prefixes_t =
+            std::vector<uint64_t>;
+
 private:
     data_t m_data;
 
     uint16_t m_key_count{static_cast<uint16_t>(-1)};
+    uint16_t m_restart_interval{restart_interval};
     uint64_t m_next_node{static_cast<uint64_t>(-1)};
 
+    prefixes_t m_prefixes;
+    uint16_t m_prefix_offset{0};
+
 private:
     const entry* entry_at(uint16_t ndx) const;
 
+    void load_prefixes();
+
+    uint16_t prefix_bound(uint64_t prefix, bool upper) const;
+
+private:
+    static uint64_t prefix_of(const std::string_view& key, uint16_t offset);
+
 private:
     friend class node_writer;
-} __attribute__ ((packed));
+};
 
 }
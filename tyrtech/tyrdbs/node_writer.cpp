@@ -2,6 +2,7 @@
 #include <tyrdbs/node_writer.h>
 
 #include <memory>
+#include <algorithm>
 #include <cstring>
 #include <lz4.h>
 
@@ -18,7 +19,11 @@ uint32_t node_writer::flush(char* sink, uint32_t sink_size)
 
     assert(likely(sink_size >= LZ4_COMPRESSBOUND(node::node_size)));
 
-    *reinterpret_cast<uint16_t*>(m_data->data()) = m_key_count;
+    auto h = reinterpret_cast<node::header*>(m_data->data());
+
+    h->key_count = m_key_count;
+    h->format = node::format;
+    h->restart_interval = node::restart_interval;
 
     int32_t r = LZ4_compress_default(m_data->data(),
                                      sink,
@@ -37,6 +42,8 @@ std::shared_ptr<node> node_writer::reset()
 {
     assert(likely(m_node != nullptr));
     m_node->m_key_count = m_key_count;
+    m_node->m_restart_interval = node::restart_interval;
+    m_node->load_prefixes();
 
     return std::move(m_node);
 }
@@ -48,12 +55,27 @@ void node_writer::internal_reset()
     m_data = &m_node->m_data;
     m_data->fill(0);
 
-    m_entry_offset = sizeof(node::m_key_count);
+    m_entry_offset = sizeof(node::header);
     m_data_offset = m_data->size();
 
     m_key_count = 0;
 }
 
+uint16_t node_writer::shared_prefix_size(const std::string_view& key) const
+{
+    if ((m_key_count % node::restart_interval) == 0)
+    {
+        return 0;
+    }
+
+    auto&& last_key = m_last_key.data();
+    uint16_t size = std::min(key.size(), last_key.size());
+
+    auto&& res = std::mismatch(key.begin(), key.begin() + size, last_key.begin());
+
+    return res.first - key.begin();
+}
+
 node::entry* node_writer::next_entry()
 {
     node::entry* entry = reinterpret_cast<node::entry*>(m_data->data() + m_entry_offset);
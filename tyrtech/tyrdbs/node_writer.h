@@ -3,6 +3,7 @@
 
 #include <common/branch_prediction.h>
 #include <tyrdbs/node.h>
+#include <tyrdbs/key_buffer.h>
 
 #include <cassert>
 
@@ -18,6 +19,7 @@ public:
                 const std::string_view& value,
                 bool eor,
                 bool deleted,
+                bool indirect,
                 const Attributes& attributes,
                 bool no_split)
     {
@@ -29,14 +31,17 @@ public:
             internal_reset();
         }
 
-        if (has_enough_space<Attributes>(key, value, no_split) == false)
+        uint16_t shared_size = shared_prefix_size(key);
+        auto&& suffix = key.substr(shared_size);
+
+        if (has_enough_space<Attributes>(suffix, value, no_split) == false)
         {
             return -1;
         }
 
         node::entry* entry = next_entry();
 
-        auto&& copied_key = copy(key);
+        auto&& copied_key = copy(suffix);
         auto&& copied_value = copy(value, sizeof(attributes));
 
         copy(attributes);
@@ -46,6 +51,10 @@ public:
         entry->key_size = copied_key.size();
         entry->eor = eor && value.size() == copied_value.size();
         entry->deleted = deleted;
+        entry->indirect = indirect;
+        entry->shared_size = shared_size;
+
+        m_last_key.assign(key);
 
         return copied_value.size();
     }
@@ -63,6 +72,8 @@ private:
 
     uint16_t m_key_count{0};
 
+    key_buffer m_last_key;
+
 private:
     template<typename Attributes>
     bool has_enough_space(const std::string_view& key,
@@ -102,6 +113,8 @@ private:
 
     void internal_reset();
 
+    uint16_t shared_prefix_size(const std::string_view& key) const;
+
     node::entry* next_entry();
 
     void allocate(uint16_t size);
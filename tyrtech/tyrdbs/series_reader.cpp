@@ -0,0 +1,115 @@
+#include <tyrdbs/series_reader.h>
+
+#include <algorithm>
+
+
+namespace tyrtech::tyrdbs {
+
+
+bool series_reader::next()
+{
+    if (m_ndx < m_points.size())
+    {
+        m_ndx++;
+    }
+
+    while (m_ndx == m_points.size())
+    {
+        if (load_next() == false)
+        {
+            return false;
+        }
+    }
+
+    if (m_points[m_ndx].timestamp > m_max_timestamp)
+    {
+        m_it.reset();
+
+        m_points.clear();
+        m_ndx = 0;
+
+        return false;
+    }
+
+    return true;
+}
+
+uint64_t series_reader::timestamp() const
+{
+    return m_points[m_ndx].timestamp;
+}
+
+uint64_t series_reader::value() const
+{
+    return m_points[m_ndx].value;
+}
+
+series_reader::series_reader(ushard* ushard,
+                             const std::string_view& series,
+                             uint64_t min_timestamp,
+                             uint64_t max_timestamp,
+                             uint64_t bucket_size)
+  : m_min_timestamp(min_timestamp)
+  , m_max_timestamp(max_timestamp)
+{
+    assert(likely(min_timestamp <= max_timestamp));
+
+    m_it = ushard->range(chunk::key(series, chunk::bucket(min_timestamp, bucket_size)),
+                         chunk::key(series, chunk::bucket(max_timestamp, bucket_size)));
+}
+
+bool series_reader::load_next()
+{
+    m_points.clear();
+    m_ndx = 0;
+
+    if (m_it == nullptr)
+    {
+        return false;
+    }
+
+    while (m_it->next() == true)
+    {
+        std::string_view value = m_it->value();
+
+        if (m_it->eor() == false)
+        {
+            m_value.assign(value);
+
+            while (m_it->eor() == false)
+            {
+                bool has_next = m_it->next();
+                assert(likely(has_next == true));
+
+                m_value.append(m_it->value());
+            }
+
+            value = m_value;
+        }
+
+        if (m_it->deleted() == true)
+        {
+            continue;
+        }
+
+        chunk::decode(value, &m_points);
+
+        auto it = std::lower_bound(m_points.begin(),
+                                   m_points.end(),
+                                   m_min_timestamp,
+                                   [](auto&& p, uint64_t timestamp)
+        {
+            return p.timestamp < timestamp;
+        });
+
+        m_ndx = it - m_points.begin();
+
+        return true;
+    }
+
+    m_it.reset();
+
+    return false;
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+
+#include <tyrdbs/chunk.h>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class series_reader : private disallow_copy, disallow_move
+{
+public:
+    bool next();
+
+    uint64_t timestamp() const;
+    uint64_t value() const;
+
+public:
+    series_reader(ushard* ushard,
+                  const std::string_view& series,
+                  uint64_t min_timestamp,
+                  uint64_t max_timestamp,
+                  uint64_t bucket_size);
+
+private:
+    std::unique_ptr<iterator> m_it;
+
+    uint64_t m_min_timestamp{0};
+    uint64_t m_max_timestamp{0};
+
+    chunk::points_t m_points;
+    uint32_t m_ndx{0};
+
+    std::string m_value;
+
+private:
+    bool load_next();
+};
+
+}
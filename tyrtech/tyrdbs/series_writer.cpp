@@ -0,0 +1,47 @@
+#include <tyrdbs/series_writer.h>
+
+
+namespace tyrtech::tyrdbs {
+
+
+void series_writer::add(const std::string_view& series, uint64_t timestamp, uint64_t value)
+{
+    auto&& key = chunk::key(series, chunk::bucket(timestamp, m_bucket_size));
+
+    m_chunks[key].push_back(chunk::point{timestamp, value});
+    m_points++;
+}
+
+void series_writer::flush(ushard* ushard, uint64_t idx, uint32_t expires)
+{
+    for (auto&& it : m_chunks)
+    {
+        chunk::sort(&it.second);
+
+        ushard->write(it.first,
+                      chunk::encode(it.second, false),
+                      true,
+                      false,
+                      idx,
+                      expires);
+    }
+
+    m_chunks.clear();
+    m_points = 0;
+}
+
+uint64_t series_writer::points() const
+{
+    return m_points;
+}
+
+series_writer::series_writer(uint64_t bucket_size)
+  : m_bucket_size(bucket_size)
+{
+    if (bucket_size == 0 || bucket_size > chunk::max_bucket_size)
+    {
+        throw chunk::invalid_data_error("invalid bucket size");
+    }
+}
+
+}
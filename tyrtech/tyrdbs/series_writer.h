@@ -0,0 +1,34 @@
+#pragma once
+
+
+#include <tyrdbs/chunk.h>
+
+#include <unordered_map>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class series_writer : private disallow_copy, disallow_move
+{
+public:
+    void add(const std::string_view& series, uint64_t timestamp, uint64_t value);
+    void flush(ushard* ushard, uint64_t idx, uint32_t expires);
+
+    uint64_t points() const;
+
+public:
+    series_writer(uint64_t bucket_size);
+
+private:
+    using chunks_t =
+            std::unordered_map<std::string, chunk::points_t>;
+
+private:
+    uint64_t m_bucket_size{0};
+    uint64_t m_points{0};
+
+    chunks_t m_chunks;
+};
+
+}
@@ -1,8 +1,10 @@
 #include <tyrdbs/slice.h>
 #include <tyrdbs/cache.h>
 #include <tyrdbs/location.h>
+#include <tyrdbs/key_buffer.h>
 
 #include <crc32c.h>
+#include <algorithm>
 
 
 namespace tyrtech::tyrdbs {
@@ -15,12 +17,15 @@ class slice_iterator : public iterator
 {
 public:
     bool next() override;
+    bool seek(const std::string_view& key) override;
 
     std::string_view key() const override;
     std::string_view value() const override;
     bool eor() const override;
     bool deleted() const override;
+    bool indirect() const override;
     uint64_t idx() const override;
+    uint32_t expires() const override;
 
 public:
     slice_iterator(slice* slice, std::shared_ptr<node> node, uint16_t ndx);
@@ -31,10 +36,20 @@ private:
     std::shared_ptr<node> m_node;
     uint16_t m_ndx{static_cast<uint16_t>(-1)};
 
+    std::string_view m_key;
+    key_buffer m_key_buffer;
+
     const data_attributes* m_attrs{nullptr};
 
+    slice::path_t m_path;
+
+    uint32_t m_sequential_nodes{0};
+    uint64_t m_read_ahead_end{0};
+    uint32_t m_read_ahead_pages{slice::min_read_ahead_pages};
+
 private:
     bool load_next();
+    void read_ahead(uint64_t location);
 };
 
 bool slice_iterator::next()
@@ -65,6 +80,55 @@ bool slice_iterator::next()
 
     m_ndx++;
 
+    m_key = m_node->next_key_at(m_ndx, m_key, &m_key_buffer);
+    m_attrs = m_node->attributes_at<data_attributes>(m_ndx);
+
+    return true;
+}
+
+bool slice_iterator::seek(const std::string_view& key)
+{
+    if (m_slice == nullptr)
+    {
+        return false;
+    }
+
+    key_buffer buffer;
+
+    if (key.compare(m_node->key_at(m_node->key_count() - 1, &buffer)) > 0)
+    {
+        static const std::string key_limit(node::max_key_size - 1, '\xff');
+
+        auto&& node = m_slice->find_leaf_for(&m_path, key, key_limit);
+
+        if (node == nullptr)
+        {
+            m_slice = nullptr;
+            m_node.reset();
+
+            return false;
+        }
+
+        m_node = std::move(node);
+        m_ndx = m_node->lower_bound(key);
+
+        m_sequential_nodes = 0;
+
+        assert(likely(m_ndx < m_node->key_count()));
+    }
+    else
+    {
+        uint16_t ndx = m_node->lower_bound(key);
+
+        if (m_attrs != nullptr && ndx <= m_ndx)
+        {
+            return next();
+        }
+
+        m_ndx = std::max(m_ndx, ndx);
+    }
+
+    m_key = m_node->key_at(m_ndx, &m_key_buffer);
     m_attrs = m_node->attributes_at<data_attributes>(m_ndx);
 
     return true;
@@ -72,7 +136,7 @@ bool slice_iterator::next()
 
 std::string_view slice_iterator::key() const
 {
-    return m_node->key_at(m_ndx);
+    return m_key;
 }
 
 std::string_view slice_iterator::value() const
@@ -90,17 +154,29 @@ bool slice_iterator::deleted() const
     return m_node->deleted_at(m_ndx);
 }
 
+bool slice_iterator::indirect() const
+{
+    return m_node->indirect_at(m_ndx);
+}
+
 uint64_t slice_iterator::idx() const
 {
     return m_attrs->idx;
 }
 
+uint32_t slice_iterator::expires() const
+{
+    return m_attrs->expires;
+}
+
 slice_iterator::slice_iterator(slice* slice, cache::node_ptr node, uint16_t ndx)
   : m_slice(slice)
   , m_node(std::move(node))
   , m_ndx(ndx)
 {
     assert(likely(ndx < m_node->key_count()));
+
+    m_key = m_node->key_at(m_ndx, &m_key_buffer);
 }
 
 bool slice_iterator::load_next()
@@ -114,6 +190,8 @@ bool slice_iterator::load_next()
             return false;
         }
 
+        read_ahead(location);
+
         m_node = m_slice->load(location);
 
         if (location::is_leaf_from(location) == true)
@@ -125,6 +203,29 @@ bool slice_iterator::load_next()
     return true;
 }
 
+void slice_iterator::read_ahead(uint64_t location)
+{
+    if (++m_sequential_nodes < slice::min_sequential_nodes)
+    {
+        return;
+    }
+
+    uint64_t offset = location::offset_from(location);
+    uint64_t window = static_cast<uint64_t>(m_read_ahead_pages) << storage::page_bits;
+
+    if (offset + (window >> 1) <= m_read_ahead_end)
+    {
+        return;
+    }
+
+    uint64_t start = std::max(offset, m_read_ahead_end);
+
+    m_slice->m_reader.read_ahead(start, offset + window - start);
+
+    m_read_ahead_end = offset + window;
+    m_read_ahead_pages = std::min(m_read_ahead_pages << 1, storage::max_read_ahead_pages);
+}
+
 std::unique_ptr<iterator> slice::range(const std::string_view& min_key, const std::string_view& max_key)
 {
     if (unlikely(key_count() == 0))
@@ -134,6 +235,11 @@ std::unique_ptr<iterator> slice::range(const std::string_view& min_key, const st
 
     assert(likely(min_key.compare(max_key) <= 0));
 
+    if (overlaps(min_key, max_key) == false)
+    {
+        return nullptr;
+    }
+
     uint64_t location = find_node_for(m_root, min_key, max_key);
 
     if (location::is_valid(location) == false)
@@ -160,22 +266,161 @@ std::unique_ptr<iterator> slice::begin()
     return std::make_unique<slice_iterator>(this, std::move(node), 0);
 }
 
+slice::iterators_t slice::multi_get(const key_views_t& keys, const bloom_filter::hashes_t& key_hashes)
+{
+    assert(likely(keys.size() == key_hashes.size()));
+
+    iterators_t iterators(keys.size());
+
+    path_t path;
+    key_buffer buffer;
+
+    for (uint32_t i = 0; i < keys.size(); i++)
+    {
+        auto& key = keys[i];
+
+        assert(likely(i == 0 || keys[i - 1].compare(key) < 0));
+
+        if (overlaps(key, key) == false || may_contain(key_hashes[i]) == false)
+        {
+            continue;
+        }
+
+        auto&& node = find_leaf_for(&path, key, key);
+
+        if (node == nullptr)
+        {
+            continue;
+        }
+
+        uint16_t ndx = node->lower_bound(key);
+
+        if (ndx == node->key_count() || key.compare(node->key_at(ndx, &buffer)) != 0)
+        {
+            continue;
+        }
+
+        iterators[i] = std::make_unique<slice_iterator>(this, node, ndx);
+    }
+
+    return iterators;
+}
+
+slice::keys_t slice::root_keys() const
+{
+    keys_t keys;
+
+    if (unlikely(key_count() == 0))
+    {
+        return keys;
+    }
+
+    auto&& node = load(m_root);
+    keys.reserve(node->key_count());
+
+    std::string_view key;
+    key_buffer buffer;
+
+    for (uint16_t ndx = 0; ndx < node->key_count(); ndx++)
+    {
+        key = node->next_key_at(ndx, key, &buffer);
+        keys.emplace_back(key);
+    }
+
+    return keys;
+}
+
+uint64_t slice::count(const std::string_view& min_key, const std::string_view& max_key) const
+{
+    if (overlaps(min_key, max_key) == false)
+    {
+        return 0;
+    }
+
+    return count(m_root, std::string_view(), min_key, max_key, true);
+}
+
+uint64_t slice::estimate_count(const std::string_view& min_key, const std::string_view& max_key) const
+{
+    if (overlaps(min_key, max_key) == false)
+    {
+        return 0;
+    }
+
+    return count(m_root, std::string_view(), min_key, max_key, false);
+}
+
+const std::string& slice::min_key() const
+{
+    return m_min_key;
+}
+
+const std::string& slice::max_key() const
+{
+    return m_max_key;
+}
+
+bool slice::overlaps(const std::string_view& min_key, const std::string_view& max_key) const
+{
+    if (unlikely(key_count() == 0))
+    {
+        return false;
+    }
+
+    return min_key.compare(m_max_key) <= 0 && max_key.compare(m_min_key) >= 0;
+}
+
 void slice::unlink()
 {
     assert(likely(m_unlink == false));
     m_unlink = true;
 }
 
+bool slice::may_contain(uint64_t key_hash) const
+{
+    return m_filter.may_contain(key_hash);
+}
+
 uint64_t slice::key_count() const
 {
     return m_key_count;
 }
 
+uint64_t slice::deleted_count() const
+{
+    return m_deleted_count;
+}
+
+uint64_t slice::min_idx() const
+{
+    return m_min_idx;
+}
+
+uint64_t slice::max_idx() const
+{
+    return m_max_idx;
+}
+
+uint32_t slice::max_expires() const
+{
+    return m_max_expires;
+}
+
 const storage::extents_t& slice::extents() const
 {
     return m_reader.extents();
 }
 
+const storage::file_descriptor& slice::descriptor() const
+{
+    return m_reader.descriptor();
+}
+
+const value_log::segment_ids_t& slice::segments() const
+{
+    return m_segments;
+}
+
 uint64_t slice::count()
 {
     return slice_count;
@@ -188,22 +433,48 @@ slice::slice(storage::file_reader&& reader)
     assert(likely((m_reader.size() & storage::page_mask) == 0));
     assert(likely(m_reader.size() > storage::page_size));
 
-    header h;
+    using buffer_t =
+            std::array<char, storage::page_size>;
+
+    buffer_t buffer;
 
     m_reader.pread(m_reader.size() - storage::page_size,
-                   reinterpret_cast<char*>(&h),
-                   sizeof(h));
+                   buffer.data(),
+                   buffer.size());
+
+    header h;
+    std::memcpy(&h, buffer.data(), sizeof(h));
 
     if (h.signature != signature)
     {
         throw runtime_error("invalid slice signature");
     }
 
+    if (sizeof(h) + h.min_key_size + h.max_key_size > buffer.size())
+    {
+        throw runtime_error("invalid slice header");
+    }
+
     m_key_count = h.stats.key_count;
+    m_deleted_count = h.stats.deleted_count;
+    m_min_idx = h.min_idx;
+    m_max_idx = h.max_idx;
+    m_max_expires = h.max_expires;
+
+    m_min_key.assign(buffer.data() + sizeof(h), h.min_key_size);
+    m_max_key.assign(buffer.data() + sizeof(h) + h.min_key_size, h.max_key_size);
 
     m_root = h.root;
     m_first_node_size = h.first_node_size;
 
+    m_filter.resize(h.filter_size);
+    m_reader.pread(h.filter_offset, m_filter.data(), h.filter_size);
+
+    m_segments.resize(h.segment_count);
+    m_reader.pread(h.segments_offset,
+                   reinterpret_cast<char*>(m_segments.data()),
+                   h.segment_count * sizeof(uint64_t));
+
     slice_count++;
 }
 
@@ -223,44 +494,152 @@ cache::node_ptr slice::load(uint64_t location) const
     return cache::get(m_reader, m_slice_ndx, location);
 }
 
-uint64_t slice::find_node_for(uint64_t location,
-                               const std::string_view& min_key,
-                               const std::string_view& max_key) const
+uint64_t slice::count(uint64_t location,
+                      const std::string_view& first_key,
+                      const std::string_view& min_key,
+                      const std::string_view& max_key,
+                      bool exact) const
 {
-    while (true)
+    auto&& node = load(location);
+
+    if (location::is_leaf_from(location) == true)
     {
-        auto&& node = load(location);
-        uint16_t ndx = node->lower_bound(min_key);
+        return count_keys(node.get(), first_key, min_key, max_key);
+    }
 
-        if (ndx != node->key_count())
+    uint64_t key_count = 0;
+
+    std::string_view index_min_key;
+    key_buffer buffer;
+
+    for (uint16_t ndx = 0; ndx < node->key_count(); ndx++)
+    {
+        index_min_key = node->next_key_at(ndx, index_min_key, &buffer);
+        auto index_max_key = node->value_at(ndx);
+
+        if (index_max_key.compare(min_key) < 0)
+        {
+            continue;
+        }
+
+        if (index_min_key.compare(max_key) > 0)
         {
-            int32_t cmp = min_key.compare(node->key_at(ndx));
-            assert(likely(cmp <= 0));
+            break;
+        }
 
-            if (cmp < 0 && ndx != 0)
-            {
-                ndx--;
-            }
+        auto attributes = node->template attributes_at<index_attributes>(ndx);
+
+        if (index_min_key.compare(min_key) >= 0 && index_max_key.compare(max_key) <= 0)
+        {
+            key_count += attributes->key_count;
+        }
+        else if (exact == true || location::is_leaf_from(attributes->location) == false)
+        {
+            key_count += count(attributes->location, index_min_key, min_key, max_key, exact);
         }
         else
         {
-            ndx--;
+            key_count += (attributes->key_count + 1) / 2;
         }
+    }
 
-        auto index_min_key = node->key_at(ndx);
-        auto index_max_key = node->value_at(ndx);
+    return key_count;
+}
+
+uint64_t slice::count_keys(const node* node,
+                           const std::string_view& first_key,
+                           const std::string_view& min_key,
+                           const std::string_view& max_key) const
+{
+    auto&& lower_key = std::max(first_key, min_key);
 
-        if (min_key.compare(index_max_key) > 0)
+    uint64_t key_count = 0;
+    key_buffer last_key;
+
+    uint16_t ndx = node->lower_bound(lower_key);
+
+    std::string_view key;
+    key_buffer buffer;
+
+    if (ndx < node->key_count())
+    {
+        key = node->key_at(ndx, &buffer);
+    }
+
+    while (ndx < node->key_count())
+    {
+        if (key.compare(max_key) > 0)
         {
-            return static_cast<uint64_t>(-1);
+            break;
         }
 
-        if (max_key.compare(index_min_key) < 0)
+        if (key_count == 0 || key.compare(last_key.data()) != 0)
         {
-            return static_cast<uint64_t>(-1);
+            last_key.assign(key);
+            key_count++;
+        }
+
+        if (++ndx < node->key_count())
+        {
+            key = node->next_key_at(ndx, key, &buffer);
+        }
+    }
+
+    return key_count;
+}
+
+std::shared_ptr<node> slice::find_leaf_for(path_t* path,
+                                           const std::string_view& min_key,
+                                           const std::string_view& max_key) const
+{
+    while (path->size() > 1)
+    {
+        auto&& node = path->back().first;
+        uint16_t ndx = node->key_count() - 1;
+
+        key_buffer buffer;
+        auto last_key = path->back().second ? node->key_at(ndx, &buffer) : node->value_at(ndx);
+
+        if (min_key.compare(last_key) <= 0)
+        {
+            break;
+        }
+
+        path->pop_back();
+    }
+
+    if (path->size() == 0)
+    {
+        path->emplace_back(load(m_root), false);
+    }
+
+    while (path->back().second == false)
+    {
+        uint64_t location = find_child_for(path->back().first.get(), min_key, max_key);
+
+        if (location == static_cast<uint64_t>(-1))
+        {
+            return nullptr;
         }
 
-        location = node->template attributes_at<index_attributes>(ndx)->location;
+        path->emplace_back(load(location), location::is_leaf_from(location));
+    }
+
+    return path->back().first;
+}
+
+uint64_t slice::find_node_for(uint64_t location,
+                               const std::string_view& min_key,
+                               const std::string_view& max_key) const
+{
+    while (true)
+    {
+        location = find_child_for(load(location).get(), min_key, max_key);
+
+        if (location == static_cast<uint64_t>(-1))
+        {
+            break;
+        }
 
         if (location::is_leaf_from(location) == true)
         {
@@ -271,4 +650,48 @@ uint64_t slice::find_node_for(uint64_t location,
     return location;
 }
 
+uint64_t slice::find_child_for(const node* node,
+                                const std::string_view& min_key,
+                                const std::string_view& max_key) const
+{
+    uint16_t ndx = node->lower_bound(min_key);
+
+    key_buffer buffer;
+
+    if (ndx != node->key_count())
+    {
+        int32_t cmp = min_key.compare(node->key_at(ndx, &buffer));
+        assert(likely(cmp <= 0));
+
+        if (cmp < 0 && ndx != 0)
+        {
+            ndx--;
+        }
+    }
+    else
+    {
+        ndx--;
+    }
+
+    auto index_min_key = node->key_at(ndx, &buffer);
+    auto index_max_key = node->value_at(ndx);
+
+    if (min_key.compare(index_max_key) > 0)
+    {
+        if (ndx + 1 == node->key_count())
+        {
+            return static_cast<uint64_t>(-1);
+        }
+
+        index_min_key = node->key_at(++ndx, &buffer);
+    }
+
+    if (max_key.compare(index_min_key) < 0)
+    {
+        return static_cast<uint64_t>(-1);
+    }
+
+    return node->template attributes_at<index_attributes>(ndx)->location;
+}
+
 }
@@ -4,7 +4,9 @@
 #include <storage/engine.h>
 #include <tyrdbs/node.h>
 #include <tyrdbs/attributes.h>
+#include <tyrdbs/bloom_filter.h>
 #include <tyrdbs/iterator.h>
+#include <tyrdbs/value_log.h>
 
 
 namespace tyrtech::tyrdbs {
@@ -12,10 +14,24 @@ namespace tyrtech::tyrdbs {
 
 class slice : private disallow_copy, disallow_move
 {
+public:
+    static constexpr uint32_t never_expires{static_cast<uint32_t>(-1)};
+
+public:
+    using keys_t =
+            std::vector<std::string>;
+
+    using key_views_t =
+            std::vector<std::string_view>;
+
+    using iterators_t =
+            std::vector<std::unique_ptr<iterator>>;
+
 public:
     struct stats
     {
         uint64_t key_count{0};
+        uint64_t deleted_count{0};
         uint64_t compressed_size{0};
         uint64_t uncompressed_size{0};
         uint64_t total_nodes{0};
@@ -26,10 +42,30 @@ public:
     std::unique_ptr<iterator> range(const std::string_view& min_key, const std::string_view& max_key);
     std::unique_ptr<iterator> begin();
 
+    iterators_t multi_get(const key_views_t& keys, const bloom_filter::hashes_t& key_hashes);
+
+    keys_t root_keys() const;
+
+    uint64_t count(const std::string_view& min_key, const std::string_view& max_key) const;
+    uint64_t estimate_count(const std::string_view& min_key, const std::string_view& max_key) const;
+
+    const std::string& min_key() const;
+    const std::string& max_key() const;
+
+    bool overlaps(const std::string_view& min_key, const std::string_view& max_key) const;
+
     void unlink();
 
+    bool may_contain(uint64_t key_hash) const;
+
     uint64_t key_count() const;
+    uint64_t deleted_count() const;
+    uint64_t min_idx() const;
+    uint64_t max_idx() const;
+    uint32_t max_expires() const;
     const storage::extents_t& extents() const;
+    const storage::file_descriptor& descriptor() const;
+    const value_log::segment_ids_t& segments() const;
 
 public:
     static uint64_t count();
@@ -41,7 +77,15 @@ public:
     ~slice();
 
 private:
-    static constexpr uint64_t signature{0x3130306264727974UL};
+    using path_t =
+            std::vector<std::pair<std::shared_ptr<node>, bool>>;
+
+private:
+    static constexpr uint32_t min_sequential_nodes{2};
+    static constexpr uint32_t min_read_ahead_pages{8};
+
+private:
+    static constexpr uint64_t signature{0x3031306264727974UL};
 
 public:
     struct header
@@ -49,6 +93,15 @@ public:
         uint64_t signature{slice::signature};
         uint64_t root{static_cast<uint64_t>(-1)};
         uint16_t first_node_size{static_cast<uint16_t>(-1)};
+        uint64_t filter_offset{0};
+        uint32_t filter_size{0};
+        uint64_t segments_offset{0};
+        uint32_t segment_count{0};
+        uint64_t min_idx{static_cast<uint64_t>(-1)};
+        uint64_t max_idx{0};
+        uint32_t max_expires{0};
+        uint16_t min_key_size{0};
+        uint16_t max_key_size{0};
         stats stats;
     } __attribute__ ((packed));
 
@@ -58,10 +111,21 @@ private:
     storage::file_reader m_reader;
 
     uint64_t m_key_count{0};
+    uint64_t m_deleted_count{0};
+    uint64_t m_min_idx{0};
+    uint64_t m_max_idx{0};
+    uint32_t m_max_expires{0};
+
+    std::string m_min_key;
+    std::string m_max_key;
 
     uint64_t m_root{static_cast<uint64_t>(-1)};
     uint64_t m_first_node_size{0};
 
+    bloom_filter m_filter;
+
+    value_log::segment_ids_t m_segments;
+
     bool m_unlink{false};
 
 private:
@@ -69,8 +133,27 @@ private:
                            const std::string_view& min_key,
                            const std::string_view& max_key) const;
 
+    uint64_t find_child_for(const node* node,
+                            const std::string_view& min_key,
+                            const std::string_view& max_key) const;
+
     std::shared_ptr<node> load(uint64_t location) const;
 
+    std::shared_ptr<node> find_leaf_for(path_t* path,
+                                        const std::string_view& min_key,
+                                        const std::string_view& max_key) const;
+
+    uint64_t count(uint64_t location,
+                   const std::string_view& first_key,
+                   const std::string_view& min_key,
+                   const std::string_view& max_key,
+                   bool exact) const;
+
+    uint64_t count_keys(const node* node,
+                        const std::string_view& first_key,
+                        const std::string_view& min_key,
+                        const std::string_view& max_key) const;
+
 private:
     friend class slice_writer;
     friend class slice_iterator;
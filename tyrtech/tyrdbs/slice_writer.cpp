@@ -3,6 +3,7 @@
 #include <tyrdbs/location.h>
 
 #include <crc32c.h>
+#include <algorithm>
 
 
 namespace tyrtech::tyrdbs {
@@ -13,7 +14,8 @@ extern thread_local uint64_t slice_count;
 
 void slice_writer::index_writer::add(const std::string_view& min_key,
                                      const std::string_view& max_key,
-                                     uint64_t location)
+                                     uint64_t location,
+                                     uint64_t key_count)
 {
     if (m_first_key.size() == 0)
     {
@@ -22,8 +24,9 @@ void slice_writer::index_writer::add(const std::string_view& min_key,
 
     index_attributes attributes;
     attributes.location = location;
+    attributes.key_count = key_count;
 
-    auto res = m_node.add(min_key, max_key, true, false, attributes, true);
+    auto res = m_node.add(min_key, max_key, true, false, false, attributes, true);
 
     if (res == -1)
     {
@@ -34,10 +37,12 @@ void slice_writer::index_writer::add(const std::string_view& min_key,
 
         location = m_writer->store(&m_node, false);
 
-        m_node.add(min_key, max_key, true, false, attributes, true);
+        m_node.add(min_key, max_key, true, false, false, attributes, true);
 
-        m_higher_level->add(m_first_key.data(), m_last_key.data(), location);
+        m_higher_level->add(m_first_key.data(), m_last_key.data(), location, m_key_count);
         m_first_key.assign(min_key);
+
+        m_key_count = 0;
     }
     else
     {
@@ -45,6 +50,7 @@ void slice_writer::index_writer::add(const std::string_view& min_key,
     }
 
     m_last_key.assign(max_key);
+    m_key_count += key_count;
 }
 
 uint64_t slice_writer::index_writer::flush()
@@ -57,7 +63,7 @@ uint64_t slice_writer::index_writer::flush()
     }
     else
     {
-        m_higher_level->add(m_first_key.data(), m_last_key.data(), location);
+        m_higher_level->add(m_first_key.data(), m_last_key.data(), location, m_key_count);
     }
 
     return m_higher_level->flush();
@@ -79,7 +85,13 @@ void slice_writer::add(iterator* it, bool compact)
             continue;
         }
 
-        add(it->key(), it->value(), it->eor(), it->deleted(), it->idx());
+        if (it->indirect() == true)
+        {
+            append(it->key(), it->value(), it->eor(), false, true, it->idx(), it->expires());
+            continue;
+        }
+
+        add(it->key(), it->value(), it->eor(), it->deleted(), it->idx(), it->expires());
     }
 }
 
@@ -87,24 +99,83 @@ void slice_writer::add(const std::string_view& key,
                        std::string_view value,
                        bool eor,
                        bool deleted,
-                       uint64_t idx)
+                       uint64_t idx,
+                       uint32_t expires)
+{
+    if (m_values != nullptr && deleted == false)
+    {
+        separate(key, value, eor, idx, expires);
+    }
+    else
+    {
+        append(key, value, eor, deleted, false, idx, expires);
+    }
+}
+
+void slice_writer::set_value_log(value_log::writer* values, uint32_t value_threshold)
+{
+    assert(likely(value_threshold != 0));
+
+    m_values = values;
+    m_value_threshold = value_threshold;
+}
+
+void slice_writer::append(const std::string_view& key,
+                          std::string_view value,
+                          bool eor,
+                          bool deleted,
+                          bool indirect,
+                          uint64_t idx,
+                          uint32_t expires)
 {
     assert(likely(m_commited == false));
     assert(likely(idx < max_idx));
 
     bool new_key = check(key, value, eor, deleted);
 
-    if (new_key == true && m_first_key.size() == 0)
+    if (new_key == true)
+    {
+        m_key_hashes.push_back(bloom_filter::hash(key));
+
+        if (m_first_key.size() == 0)
+        {
+            m_first_key.assign(key);
+        }
+
+        if (m_min_key.size() == 0)
+        {
+            m_min_key.assign(key);
+        }
+
+        m_node_keys++;
+    }
+
+    if (indirect == true)
     {
-        m_first_key.assign(key);
+        m_pointer_data.append(value);
+
+        if (eor == true)
+        {
+            uint64_t segment = value_log::decode(m_pointer_data).segment;
+
+            if (m_segments.size() == 0 || m_segments.back() != segment)
+            {
+                m_segments.push_back(segment);
+            }
+
+            m_pointer_data.clear();
+        }
     }
 
     while (true)
     {
         data_attributes attributes;
         attributes.idx = idx;
+        attributes.expires = expires;
+
+        bool is_split = false;
 
-        if (auto res = m_node.add(key, value, eor, deleted, attributes, false); res != -1)
+        if (auto res = m_node.add(key, value, eor, deleted, indirect, attributes, false); res != -1)
         {
             value = value.substr(res, value.size() - res);
 
@@ -112,21 +183,41 @@ void slice_writer::add(const std::string_view& key,
             {
                 break;
             }
+
+            is_split = true;
         }
 
         uint64_t location = store(&m_node, true);
 
         if (m_first_key.size() != 0)
         {
-            m_index.add(m_first_key.data(), m_last_key.data(), location);
-
-            if (new_key == true)
+            if (is_split == true)
             {
-                m_first_key.assign(key);
+                m_index.add(m_first_key.data(), key, location, m_node_keys);
+                m_first_key.clear();
+
+                m_node_keys = 0;
             }
             else
             {
-                m_first_key.clear();
+                if (new_key == true)
+                {
+                    if (m_node_keys > 1)
+                    {
+                        m_index.add(m_first_key.data(), m_last_key.data(), location, m_node_keys - 1);
+                    }
+
+                    m_first_key.assign(key);
+
+                    m_node_keys = 1;
+                }
+                else
+                {
+                    m_index.add(m_first_key.data(), m_last_key.data(), location, m_node_keys);
+                    m_first_key.clear();
+
+                    m_node_keys = 0;
+                }
             }
         }
     }
@@ -134,14 +225,74 @@ void slice_writer::add(const std::string_view& key,
     m_last_key.assign(key);
     m_last_eor = eor;
 
+    m_header.min_idx = std::min(m_header.min_idx, idx);
+    m_header.max_idx = std::max(m_header.max_idx, idx);
+    m_header.max_expires = std::max(m_header.max_expires, expires != 0 ? expires : slice::never_expires);
     m_header.stats.key_count++;
+    m_header.stats.deleted_count += deleted;
+}
+
+void slice_writer::separate(const std::string_view& key,
+                            const std::string_view& value,
+                            bool eor,
+                            uint64_t idx,
+                            uint32_t expires)
+{
+    if (m_value_key.size() == 0)
+    {
+        if (eor == true && value.size() <= m_value_threshold)
+        {
+            append(key, value, eor, false, false, idx, expires);
+            return;
+        }
+
+        m_value_key.assign(key);
+    }
+    else if (key.compare(m_value_key) != 0)
+    {
+        throw invalid_data_error("key eor mismatch");
+    }
+
+    if (m_pointer.size != 0)
+    {
+        m_values->append(&m_pointer, value);
+    }
+    else
+    {
+        m_value.append(value);
+
+        if (m_value.size() > m_value_threshold)
+        {
+            m_pointer = m_values->write(m_value);
+            m_value.clear();
+        }
+    }
+
+    if (eor == false)
+    {
+        return;
+    }
+
+    std::string value_key = std::move(m_value_key);
+    m_value_key.clear();
+
+    if (m_pointer.size != 0)
+    {
+        append(value_key, value_log::encode(m_pointer), true, false, true, idx, expires);
+        m_pointer = value_log::pointer();
+    }
+    else
+    {
+        append(value_key, m_value, true, false, false, idx, expires);
+        m_value.clear();
+    }
 }
 
 void slice_writer::flush()
 {
     assert(likely(m_commited == false));
 
-    if (m_last_eor == false)
+    if (m_last_eor == false || m_value_key.size() != 0)
     {
         throw invalid_data_error("data not complete");
     }
@@ -153,7 +304,7 @@ void slice_writer::flush()
 
     if (m_first_key.size() != 0)
     {
-        m_index.add(m_first_key.data(), m_last_key.data(), location);
+        m_index.add(m_first_key.data(), m_last_key.data(), location, m_node_keys);
     }
 
     m_header.root = m_index.flush();
@@ -164,7 +315,31 @@ void slice_writer::flush()
     m_writer.write(location::invalid_size);
     m_writer.add_padding();
 
+    m_filter.build(m_key_hashes);
+    m_key_hashes = bloom_filter::hashes_t();
+
+    m_header.filter_offset = m_writer.size();
+    m_header.filter_size = m_filter.size();
+
+    m_writer.write(m_filter.data(), m_filter.size());
+    m_writer.add_padding();
+
+    std::sort(m_segments.begin(), m_segments.end());
+    m_segments.erase(std::unique(m_segments.begin(), m_segments.end()), m_segments.end());
+
+    m_header.segments_offset = m_writer.size();
+    m_header.segment_count = m_segments.size();
+
+    m_writer.write(reinterpret_cast<const char*>(m_segments.data()),
+                   m_segments.size() * sizeof(uint64_t));
+    m_writer.add_padding();
+
+    m_header.min_key_size = m_min_key.size();
+    m_header.max_key_size = m_last_key.size();
+
     m_writer.write(m_header);
+    m_writer.write(m_min_key.data().data(), m_min_key.size());
+    m_writer.write(m_last_key.data().data(), m_last_key.size());
     m_writer.add_padding();
 
     m_writer.flush();
@@ -182,12 +357,25 @@ std::shared_ptr<slice> slice_writer::commit()
     c->m_slice_ndx = m_slice_ndx;
     c->m_reader = storage::create_reader(m_writer.commit());
     c->m_key_count = m_header.stats.key_count;
+    c->m_deleted_count = m_header.stats.deleted_count;
+    c->m_min_idx = m_header.min_idx;
+    c->m_max_idx = m_header.max_idx;
+    c->m_max_expires = m_header.max_expires;
+    c->m_min_key.assign(m_min_key.data());
+    c->m_max_key.assign(m_last_key.data());
     c->m_root = m_header.root;
     c->m_first_node_size = m_header.first_node_size;
+    c->m_filter = std::move(m_filter);
+    c->m_segments = std::move(m_segments);
 
     return c;
 }
 
+uint64_t slice_writer::size() const
+{
+    return m_writer.size();
+}
+
 slice_writer::slice_writer()
   : m_slice_ndx(storage::new_cache_id())
   , m_writer(storage::create_writer())
@@ -214,6 +402,11 @@ bool slice_writer::check(const std::string_view& key,
         throw invalid_data_error("key of zero length not allowed");
     }
 
+    if (m_value_key.size() != 0)
+    {
+        throw invalid_data_error("key eor mismatch");
+    }
+
     if (key.size() >= node::max_key_size)
     {
         throw invalid_data_error("maximum key size exceded");
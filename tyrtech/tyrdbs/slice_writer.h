@@ -23,11 +23,16 @@ public:
              std::string_view value,
              bool eor,
              bool deleted,
-             uint64_t idx);
+             uint64_t idx,
+             uint32_t expires);
+
+    void set_value_log(value_log::writer* values, uint32_t value_threshold);
 
     void flush();
     std::shared_ptr<slice> commit();
 
+    uint64_t size() const;
+
 public:
     slice_writer();
     ~slice_writer();
@@ -38,7 +43,8 @@ private:
     public:
         void add(const std::string_view& min_key,
                  const std::string_view& max_key,
-                 uint64_t location);
+                 uint64_t location,
+                 uint64_t key_count);
 
         uint64_t flush();
 
@@ -55,6 +61,8 @@ private:
         key_buffer m_first_key;
         key_buffer m_last_key;
 
+        uint64_t m_key_count{0};
+
         index_writer_ptr m_higher_level;
 
         slice_writer* m_writer{nullptr};
@@ -66,8 +74,12 @@ private:
     key_buffer m_first_key;
     key_buffer m_last_key;
 
+    key_buffer m_min_key;
+
     bool m_last_eor{true};
 
+    uint64_t m_node_keys{0};
+
     bool m_commited{false};
 
     storage::file_writer m_writer;
@@ -77,9 +89,36 @@ private:
 
     slice::header m_header;
 
+    bloom_filter::hashes_t m_key_hashes;
+    bloom_filter m_filter;
+
     std::shared_ptr<node> m_last_node;
 
+    value_log::writer* m_values{nullptr};
+    uint32_t m_value_threshold{0};
+
+    std::string m_value_key;
+    std::string m_value;
+    value_log::pointer m_pointer;
+
+    std::string m_pointer_data;
+    value_log::segment_ids_t m_segments;
+
 private:
+    void append(const std::string_view& key,
+                std::string_view value,
+                bool eor,
+                bool deleted,
+                bool indirect,
+                uint64_t idx,
+                uint32_t expires);
+
+    void separate(const std::string_view& key,
+                  const std::string_view& value,
+                  bool eor,
+                  uint64_t idx,
+                  uint32_t expires);
+
     bool check(const std::string_view& key,
                const std::string_view& value,
                bool eor,
@@ -1,26 +1,58 @@
+#include <common/clock.h>
 #include <gt/async.h>
 #include <tyrdbs/ushard.h>
 
+#include <crc32c.h>
+#include <algorithm>
+#include <mutex>
+
 
 namespace tyrtech::tyrdbs {
 
 
+static bool is_expired(const iterator* it, uint32_t now)
+{
+    return it->expires() != 0 && it->expires() <= now;
+}
+
+static bool skip_expired(iterator* it, uint32_t now)
+{
+    while (is_expired(it, now) == true)
+    {
+        if (it->next() == false)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 class ushard_iterator : public iterator
 {
 public:
     bool next() override;
+    bool seek(const std::string_view& key) override;
 
     std::string_view key() const override;
     std::string_view value() const override;
     bool eor() const override;
     bool deleted() const override;
+    bool indirect() const override;
     uint64_t idx() const override;
+    uint32_t expires() const override;
 
 public:
-    ushard_iterator(ushard::slices_t&& slices,
+    ushard_iterator(const ushard::slices_t& slices,
+                    ushard::memtables_t&& memtables,
                     const std::string_view& min_key,
-                    const std::string_view& max_key);
-    ushard_iterator(ushard::slices_t&& slices);
+                    const std::string_view& max_key,
+                    bool exclude_max_key,
+                    const ushard::merge_operator* merge_operator);
+    ushard_iterator(const ushard::slices_t& slices,
+                    ushard::memtables_t&& memtables,
+                    const ushard::merge_operator* merge_operator);
 
 private:
     using element_t =
@@ -29,36 +61,57 @@ private:
     using elements_t =
             std::vector<element_t>;
 
+    struct head
+    {
+        std::string_view key;
+        uint64_t idx{0};
+        bool exhausted{false};
+    };
+
+    using heads_t =
+            std::vector<head>;
+
+    using tree_t =
+            std::vector<uint32_t>;
+
 private:
     elements_t m_elements;
 
+    heads_t m_heads;
+    tree_t m_tree;
+
     key_buffer m_max_key;
     key_buffer m_last_key;
 
-private:
-    struct cmp
-    {
-        bool operator()(const element_t& e1, const element_t& e2)
-        {
-            auto& it1 = e1.second;
-            auto& it2 = e2.second;
+    bool m_exclude_max_key{false};
 
-            int32_t cmp = it1->key().compare(it2->key());
+    uint32_t m_now{ushard::now()};
 
-            if (cmp == 0)
-            {
-                return it1->idx() < it2->idx();
-            }
+    const ushard::merge_operator* m_merge_operator{nullptr};
 
-            return cmp > 0;
-        }
-    };
+    std::string m_value;
+    std::string m_older_value;
+    uint64_t m_idx{0};
+    uint32_t m_expires{0};
+    bool m_deleted{false};
 
 private:
-    bool is_out_of_bounds();
+    bool is_out_of_bounds(const std::string_view& key) const;
+
+    bool beats(uint32_t e1, uint32_t e2) const;
+
+    void build();
+    uint32_t build(uint32_t node);
+
+    void load_head(uint32_t ndx);
+    uint32_t winner() const;
 
     bool advance_last();
     bool advance();
+
+    bool fold();
+    bool is_same_key() const;
+    void read_value(std::string* value);
 };
 
 bool ushard_iterator::next()
@@ -68,12 +121,17 @@ bool ushard_iterator::next()
         return false;
     }
 
-    if (m_last_key.size() == 0)
+    if (m_merge_operator != nullptr)
     {
-        std::sort(m_elements.begin(), m_elements.end(), cmp());
-        m_last_key.assign(m_elements.back().second->key());
+        return fold();
+    }
+
+    if (m_tree.size() == 0)
+    {
+        build();
+        m_last_key.assign(key());
 
-        if (is_out_of_bounds() == true)
+        if (is_out_of_bounds(key()) == true)
         {
             m_elements.clear();
             return false;
@@ -92,7 +150,7 @@ bool ushard_iterator::next()
 
     while (advance() == true)
     {
-        if (is_out_of_bounds() == true)
+        if (is_out_of_bounds(key()) == true)
         {
             m_elements.clear();
             return false;
@@ -105,45 +163,199 @@ bool ushard_iterator::next()
         }
     }
 
+    m_elements.clear();
+
     return false;
 }
 
+bool ushard_iterator::seek(const std::string_view& key)
+{
+    if (m_elements.size() == 0)
+    {
+        return false;
+    }
+
+    if (m_tree.size() == 0)
+    {
+        auto&& is_exhausted = [this, &key](element_t& element)
+        {
+            auto& it = element.second;
+
+            if (it->key().compare(key) >= 0)
+            {
+                return false;
+            }
+
+            return it->seek(key) == false || skip_expired(it.get(), m_now) == false;
+        };
+
+        m_elements.erase(std::remove_if(m_elements.begin(), m_elements.end(), is_exhausted),
+                         m_elements.end());
+
+        return next();
+    }
+
+    if (key.compare(m_last_key.data()) <= 0)
+    {
+        return next();
+    }
+
+    for (uint32_t ndx = 0; ndx < m_elements.size(); ndx++)
+    {
+        auto& h = m_heads[ndx];
+
+        if (h.exhausted == true || h.key.compare(key) >= 0)
+        {
+            continue;
+        }
+
+        auto& it = m_elements[ndx].second;
+
+        if (it->seek(key) == false || skip_expired(it.get(), m_now) == false)
+        {
+            h.exhausted = true;
+            continue;
+        }
+
+        load_head(ndx);
+    }
+
+    m_tree[0] = build(1);
+
+    if (m_merge_operator != nullptr)
+    {
+        return fold();
+    }
+
+    auto& h = m_heads[winner()];
+
+    if (h.exhausted == true || is_out_of_bounds(h.key) == true)
+    {
+        m_elements.clear();
+        return false;
+    }
+
+    m_last_key.assign(h.key);
+
+    return true;
+}
+
 std::string_view ushard_iterator::key() const
 {
-    return m_elements.back().second->key();
+    if (m_merge_operator != nullptr)
+    {
+        return m_last_key.data();
+    }
+
+    return m_heads[winner()].key;
 }
 
 std::string_view ushard_iterator::value() const
 {
-    return m_elements.back().second->value();
+    if (m_merge_operator != nullptr)
+    {
+        return m_value;
+    }
+
+    return m_elements[winner()].second->value();
 }
 
 bool ushard_iterator::eor() const
 {
-    return m_elements.back().second->eor();
+    if (m_merge_operator != nullptr)
+    {
+        return true;
+    }
+
+    return m_elements[winner()].second->eor();
 }
 
 bool ushard_iterator::deleted() const
 {
-    return m_elements.back().second->deleted();
+    if (m_merge_operator != nullptr)
+    {
+        return m_deleted;
+    }
+
+    return m_elements[winner()].second->deleted();
+}
+
+bool ushard_iterator::indirect() const
+{
+    if (m_merge_operator != nullptr)
+    {
+        return false;
+    }
+
+    return m_elements[winner()].second->indirect();
 }
 
 uint64_t ushard_iterator::idx() const
 {
-    return m_elements.back().second->idx();
+    if (m_merge_operator != nullptr)
+    {
+        return m_idx;
+    }
+
+    return m_heads[winner()].idx;
+}
+
+uint32_t ushard_iterator::expires() const
+{
+    if (m_merge_operator != nullptr)
+    {
+        return m_expires;
+    }
+
+    return m_elements[winner()].second->expires();
 }
 
-ushard_iterator::ushard_iterator(ushard::slices_t&& slices,
+ushard_iterator::ushard_iterator(const ushard::slices_t& slices,
+                                 ushard::memtables_t&& memtables,
                                  const std::string_view& min_key,
-                                 const std::string_view& max_key)
+                                 const std::string_view& max_key,
+                                 bool exclude_max_key,
+                                 const ushard::merge_operator* merge_operator)
+  : m_exclude_max_key(exclude_max_key)
+  , m_merge_operator(merge_operator)
 {
-    m_elements.reserve(slices.size());
+    m_elements.reserve(slices.size() + memtables.size());
+
+    for (auto&& memtable : memtables)
+    {
+        auto&& it = memtable->range(min_key);
+
+        if (it->next() == false || skip_expired(it.get(), m_now) == false)
+        {
+            continue;
+        }
+
+        if (it->key().compare(max_key) > 0)
+        {
+            continue;
+        }
+
+        m_elements.emplace_back(element_t(nullptr, std::move(it)));
+    }
+
+    bool is_point = min_key.compare(max_key) == 0;
+    uint64_t key_hash = is_point ? bloom_filter::hash(min_key) : 0;
 
     auto jobs = gt::async::create_jobs();
 
     for (auto&& slice : slices)
     {
-        auto f = [this, slice = std::move(slice), &min_key, &max_key]
+        if (slice->overlaps(min_key, max_key) == false)
+        {
+            continue;
+        }
+
+        if (is_point == true && slice->may_contain(key_hash) == false)
+        {
+            continue;
+        }
+
+        auto f = [this, slice, &min_key, &max_key]
         {
             auto&& it = slice->range(min_key, max_key);
 
@@ -152,7 +364,7 @@ ushard_iterator::ushard_iterator(ushard::slices_t&& slices,
                 return;
             }
 
-            if (it->next() == false)
+            if (it->next() == false || skip_expired(it.get(), m_now) == false)
             {
                 return;
             }
@@ -177,9 +389,22 @@ ushard_iterator::ushard_iterator(ushard::slices_t&& slices,
     }
 }
 
-ushard_iterator::ushard_iterator(ushard::slices_t&& slices)
+ushard_iterator::ushard_iterator(const ushard::slices_t& slices,
+                                 ushard::memtables_t&& memtables,
+                                 const ushard::merge_operator* merge_operator)
+  : m_merge_operator(merge_operator)
 {
-    m_elements.reserve(slices.size());
+    m_elements.reserve(slices.size() + memtables.size());
+
+    for (auto&& memtable : memtables)
+    {
+        auto&& it = memtable->begin();
+
+        if (it->next() == true && skip_expired(it.get(), m_now) == true)
+        {
+            m_elements.emplace_back(element_t(nullptr, std::move(it)));
+        }
+    }
 
     for (auto&& slice : slices)
     {
@@ -190,224 +415,1601 @@ ushard_iterator::ushard_iterator(ushard::slices_t&& slices)
             continue;
         }
 
-        if (it->next() == true)
+        if (it->next() == true && skip_expired(it.get(), m_now) == true)
         {
-            this->m_elements.emplace_back(element_t(std::move(slice),
-                                                    std::move(it)));
+            this->m_elements.emplace_back(element_t(slice, std::move(it)));
         }
     }
 }
 
-bool ushard_iterator::is_out_of_bounds()
+bool ushard_iterator::is_out_of_bounds(const std::string_view& key) const
 {
     if (m_max_key.size() == 0)
     {
         return false;
     }
 
-    return key().compare(m_max_key.data()) > 0;
-}
+    int32_t cmp = key.compare(m_max_key.data());
 
-bool ushard_iterator::advance_last()
-{
-    return m_elements.back().second->next();
+    if (m_exclude_max_key == true)
+    {
+        return cmp >= 0;
+    }
+
+    return cmp > 0;
 }
 
-bool ushard_iterator::advance()
+bool ushard_iterator::beats(uint32_t e1, uint32_t e2) const
 {
-    bool has_next = advance_last();
+    auto& h1 = m_heads[e1];
+    auto& h2 = m_heads[e2];
 
-    if (has_next == false)
+    if (h1.exhausted == true || h2.exhausted == true)
     {
-        m_elements.pop_back();
-        return m_elements.size() != 0;
+        return h2.exhausted == true && h1.exhausted == false;
     }
 
-    auto&& it = std::lower_bound(m_elements.begin(),
-                                 m_elements.end(),
-                                 m_elements.back(),
-                                 cmp());
+    int32_t cmp = h1.key.compare(h2.key);
 
-    if (it != --m_elements.end())
+    if (cmp == 0)
     {
-        element_t e = std::move(m_elements.back());
-        m_elements.insert(it, std::move(e));
+        return h1.idx > h2.idx;
+    }
+
+    return cmp < 0;
+}
+
+void ushard_iterator::build()
+{
+    uint32_t count = m_elements.size();
 
-        m_elements.pop_back();
+    m_heads.resize(count);
+
+    for (uint32_t ndx = 0; ndx < count; ndx++)
+    {
+        load_head(ndx);
     }
 
-    return true;
+    m_tree.resize(count);
+    m_tree[0] = build(1);
 }
 
-std::unique_ptr<iterator> ushard::range(const std::string_view& min_key,
-                                        const std::string_view& max_key)
+uint32_t ushard_iterator::build(uint32_t node)
 {
-    return std::make_unique<ushard_iterator>(get_slices(), min_key, max_key);
+    uint32_t count = m_elements.size();
+
+    if (node >= count)
+    {
+        return node - count;
+    }
+
+    uint32_t e1 = build(node << 1);
+    uint32_t e2 = build((node << 1) + 1);
+
+    if (beats(e1, e2) == true)
+    {
+        m_tree[node] = e2;
+        return e1;
+    }
+
+    m_tree[node] = e1;
+
+    return e2;
 }
 
-std::unique_ptr<iterator> ushard::begin()
+void ushard_iterator::load_head(uint32_t ndx)
 {
-    return std::make_unique<ushard_iterator>(get_slices());
+    auto& it = m_elements[ndx].second;
+    auto& h = m_heads[ndx];
+
+    h.key = it->key();
+    h.idx = it->idx();
 }
 
-void ushard::add(slice_ptr slice, meta_callback* cb)
+uint32_t ushard_iterator::winner() const
 {
-    add(std::move(slice), cb, true);
+    return m_tree[0];
 }
 
-uint64_t ushard::merge(uint32_t tier, meta_callback* cb)
+bool ushard_iterator::advance_last()
 {
-    auto&& tier_slices = get_slices_for(tier);
-    uint32_t count = tier_slices.size();
+    uint32_t ndx = winner();
+    auto& it = m_elements[ndx].second;
 
-    if (count <= max_slices_per_tier)
+    if (it->next() == false || skip_expired(it.get(), m_now) == false)
     {
-        return 0;
+        m_heads[ndx].exhausted = true;
+        return false;
     }
 
-    cb->remove(tier_slices);
+    load_head(ndx);
 
-    auto source_key_count = key_count(tier_slices);
+    return true;
+}
+
+bool ushard_iterator::advance()
+{
+    uint32_t e = winner();
 
-    slice_writer target;
-    ushard_iterator it(std::move(tier_slices));
+    advance_last();
 
-    target.add(&it, false);
-    target.flush();
+    for (uint32_t node = (e + m_elements.size()) >> 1; node != 0; node >>= 1)
+    {
+        if (beats(m_tree[node], e) == true)
+        {
+            std::swap(m_tree[node], e);
+        }
+    }
 
-    add(target.commit(), cb);
-    remove_from(tier, count, cb);
+    m_tree[0] = e;
 
-    return source_key_count;
+    return m_heads[e].exhausted == false;
 }
 
-uint64_t ushard::compact(meta_callback* cb)
+bool ushard_iterator::fold()
 {
-    auto&& slices = get_slices();
+    if (m_tree.size() == 0)
+    {
+        build();
+    }
+
+    auto& h = m_heads[winner()];
 
-    if (slices.size() < 2)
+    if (h.exhausted == true || is_out_of_bounds(h.key) == true)
     {
-        return 0;
+        m_elements.clear();
+        return false;
     }
 
-    cb->remove(slices);
+    m_last_key.assign(h.key);
+    m_idx = h.idx;
+    m_expires = m_elements[winner()].second->expires();
+    m_deleted = m_elements[winner()].second->deleted();
+
+    read_value(&m_value);
 
-    auto source_key_count = key_count(slices);
+    bool truncated = m_deleted;
+    uint64_t last_idx = m_idx;
+
+    while (is_same_key() == true)
+    {
+        uint64_t idx = m_heads[winner()].idx;
 
-    tier_map_t tier_map_checkpoint = m_tier_map;
+        if (truncated == true || idx == last_idx)
+        {
+            read_value(nullptr);
+            continue;
+        }
 
-    slice_writer target;
-    ushard_iterator it(std::move(slices));
+        last_idx = idx;
 
-    target.add(&it, true);
-    target.flush();
+        if (m_elements[winner()].second->deleted() == true)
+        {
+            m_merge_operator->truncate(m_last_key.data(), &m_value);
+            truncated = true;
 
-    add(target.commit(), cb);
+            read_value(nullptr);
+            continue;
+        }
 
-    for (auto&& it : tier_map_checkpoint)
-    {
-        remove_from(it.first, it.second.size(), cb);
+        read_value(&m_older_value);
+        m_merge_operator->merge(m_last_key.data(), m_older_value, &m_value);
     }
 
-    return source_key_count;
-}
-
-void ushard::drop()
-{
-    m_dropped = true;
+    return true;
 }
 
-ushard::slices_t ushard::get_slices() const
+bool ushard_iterator::is_same_key() const
 {
-    slices_t slices;
+    auto& h = m_heads[winner()];
 
-    for (auto&& it : m_tier_map)
+    if (h.exhausted == true)
     {
-        std::copy(it.second.begin(),
-                  it.second.end(),
-                  std::back_inserter(slices));
+        return false;
     }
 
-    return slices;
+    return h.key.compare(m_last_key.data()) == 0;
 }
 
-ushard::~ushard()
+void ushard_iterator::read_value(std::string* value)
 {
-    if (m_dropped == false)
+    if (value != nullptr)
     {
-        return;
+        value->clear();
     }
 
-    for (auto&& slice : get_slices())
+    while (true)
     {
-        slice->unlink();
+        auto& it = m_elements[winner()].second;
+
+        if (value != nullptr)
+        {
+            value->append(it->value());
+        }
+
+        if (it->eor() == true)
+        {
+            break;
+        }
+
+        bool has_next = advance_last();
+        assert(likely(has_next == true));
     }
 
-    m_tier_map.clear();
+    advance();
 }
 
-uint32_t ushard::tier_of(const slice_ptr& slice)
+class point_iterator : public iterator
 {
-    return (64 - __builtin_clzll(slice->key_count())) >> 2;
-}
+public:
+    bool next() override;
+    bool seek(const std::string_view& key) override;
 
-ushard::slices_t ushard::get_slices_for(uint32_t tier)
-{
-    auto&& tier_slices = m_tier_map[tier];
-    slices_t slices;
+    std::string_view key() const override;
+    std::string_view value() const override;
+    bool eor() const override;
+    bool deleted() const override;
+    bool indirect() const override;
+    uint64_t idx() const override;
+    uint32_t expires() const override;
 
-    slices.reserve(tier_slices.size());
+public:
+    point_iterator(ushard::slice_ptr slice, std::unique_ptr<iterator> it);
+    point_iterator() = default;
 
-    std::copy(tier_slices.begin(),
-              tier_slices.end(),
-              std::back_inserter(slices));
+private:
+    ushard::slice_ptr m_slice;
+    std::unique_ptr<iterator> m_it;
 
-    return slices;
-}
+    bool m_first{true};
+};
 
-uint64_t ushard::key_count(const slices_t& slices)
+bool point_iterator::next()
 {
-    uint64_t key_count = 0;
-
-    for (auto&& slice : slices)
+    if (m_it == nullptr)
     {
-        key_count += slice->key_count();
+        return false;
     }
 
-    return key_count;
-}
-
-void ushard::add(slice_ptr slice, meta_callback* cb, bool use_add_callback)
-{
-    if (use_add_callback == true)
+    if (m_first == true)
     {
-        cb->add(slice);
+        m_first = false;
+        return true;
     }
 
-    uint32_t tier = tier_of(slice);
-    auto&& it = m_tier_map.find(tier);
-
-    if (it == m_tier_map.end())
+    if (m_it->eor() == true)
     {
-        it = m_tier_map.insert(tier_map_t::value_type(tier, slices_t())).first;
+        m_it.reset();
+        m_slice.reset();
+
+        return false;
     }
 
-    it->second.emplace_back(std::move(slice));
+    bool has_next = m_it->next();
+    assert(likely(has_next == true));
+
+    return true;
+}
 
-    if (it->second.size() > max_slices_per_tier)
+bool point_iterator::seek(const std::string_view& key)
+{
+    if (m_it != nullptr && key.compare(m_it->key()) > 0)
     {
-        cb->merge(tier);
+        m_it.reset();
+        m_slice.reset();
     }
+
+    return next();
 }
 
-void ushard::remove_from(uint32_t tier, uint32_t count, meta_callback* cb)
+std::string_view point_iterator::key() const
 {
-    auto& tier_slices = m_tier_map[tier];
-    tier_slices.erase(tier_slices.begin(), tier_slices.begin() + count);
+    return m_it->key();
+}
+
+std::string_view point_iterator::value() const
+{
+    return m_it->value();
+}
+
+bool point_iterator::eor() const
+{
+    return m_it->eor();
+}
+
+bool point_iterator::deleted() const
+{
+    return m_it->deleted();
+}
+
+bool point_iterator::indirect() const
+{
+    return m_it->indirect();
+}
+
+uint64_t point_iterator::idx() const
+{
+    return m_it->idx();
+}
+
+uint32_t point_iterator::expires() const
+{
+    return m_it->expires();
+}
+
+point_iterator::point_iterator(ushard::slice_ptr slice, std::unique_ptr<iterator> it)
+  : m_slice(std::move(slice))
+  , m_it(std::move(it))
+{
+}
+
+class chain_iterator : public iterator
+{
+public:
+    bool next() override;
+    bool seek(const std::string_view& key) override;
+
+    std::string_view key() const override;
+    std::string_view value() const override;
+    bool eor() const override;
+    bool deleted() const override;
+    bool indirect() const override;
+    uint64_t idx() const override;
+    uint32_t expires() const override;
+
+public:
+    chain_iterator(slice::iterators_t&& iterators);
+
+private:
+    slice::iterators_t m_iterators;
+    uint32_t m_ndx{0};
+};
+
+bool chain_iterator::next()
+{
+    while (m_ndx < m_iterators.size())
+    {
+        if (m_iterators[m_ndx]->next() == true)
+        {
+            return true;
+        }
+
+        m_iterators[m_ndx++].reset();
+    }
+
+    return false;
+}
+
+bool chain_iterator::seek(const std::string_view& key)
+{
+    while (m_ndx < m_iterators.size())
+    {
+        if (m_iterators[m_ndx]->seek(key) == true)
+        {
+            return true;
+        }
+
+        m_iterators[m_ndx++].reset();
+    }
+
+    return false;
+}
+
+std::string_view chain_iterator::key() const
+{
+    return m_iterators[m_ndx]->key();
+}
+
+std::string_view chain_iterator::value() const
+{
+    return m_iterators[m_ndx]->value();
+}
+
+bool chain_iterator::eor() const
+{
+    return m_iterators[m_ndx]->eor();
+}
+
+bool chain_iterator::deleted() const
+{
+    return m_iterators[m_ndx]->deleted();
+}
+
+bool chain_iterator::indirect() const
+{
+    return m_iterators[m_ndx]->indirect();
+}
+
+uint64_t chain_iterator::idx() const
+{
+    return m_iterators[m_ndx]->idx();
+}
+
+uint32_t chain_iterator::expires() const
+{
+    return m_iterators[m_ndx]->expires();
+}
+
+chain_iterator::chain_iterator(slice::iterators_t&& iterators)
+  : m_iterators(std::move(iterators))
+{
+}
+
+class value_iterator : public iterator
+{
+public:
+    bool next() override;
+    bool seek(const std::string_view& key) override;
+
+    std::string_view key() const override;
+    std::string_view value() const override;
+    bool eor() const override;
+    bool deleted() const override;
+    bool indirect() const override;
+    uint64_t idx() const override;
+    uint32_t expires() const override;
+
+public:
+    value_iterator(value_log::snapshot_ptr segments, std::unique_ptr<iterator> it);
+
+private:
+    value_log::snapshot_ptr m_segments;
+    std::unique_ptr<iterator> m_it;
+
+    value_log::segment_ptr m_segment;
+    value_log::pointer m_pointer;
+    uint32_t m_offset{0};
+    uint32_t m_crc{0};
+
+    std::string m_value;
+
+private:
+    bool follow();
+    void load();
+};
+
+bool value_iterator::next()
+{
+    if (m_segment != nullptr)
+    {
+        if (m_offset < m_pointer.size)
+        {
+            load();
+            return true;
+        }
+
+        m_segment.reset();
+    }
+
+    if (m_it->next() == false)
+    {
+        return false;
+    }
+
+    return follow();
+}
+
+bool value_iterator::seek(const std::string_view& key)
+{
+    if (m_segment != nullptr)
+    {
+        if (key.compare(m_it->key()) <= 0)
+        {
+            return next();
+        }
+
+        m_segment.reset();
+    }
+
+    if (m_it->seek(key) == false)
+    {
+        return false;
+    }
+
+    return follow();
+}
+
+bool value_iterator::follow()
+{
+    if (m_it->indirect() == false)
+    {
+        return true;
+    }
+
+    m_value.assign(m_it->value());
+
+    while (m_it->eor() == false)
+    {
+        bool has_next = m_it->next();
+        assert(likely(has_next == true));
+
+        m_value.append(m_it->value());
+    }
+
+    m_pointer = value_log::decode(m_value);
+    m_segment = value_log::get(m_segments, m_pointer.segment);
+    m_offset = 0;
+    m_crc = 0;
+
+    load();
+
+    return true;
+}
+
+std::string_view value_iterator::key() const
+{
+    return m_it->key();
+}
+
+std::string_view value_iterator::value() const
+{
+    if (m_segment != nullptr)
+    {
+        return m_value;
+    }
+
+    return m_it->value();
+}
+
+bool value_iterator::eor() const
+{
+    if (m_segment != nullptr)
+    {
+        return m_offset == m_pointer.size;
+    }
+
+    return m_it->eor();
+}
+
+bool value_iterator::deleted() const
+{
+    return m_it->deleted();
+}
+
+bool value_iterator::indirect() const
+{
+    return false;
+}
+
+uint64_t value_iterator::idx() const
+{
+    return m_it->idx();
+}
+
+uint32_t value_iterator::expires() const
+{
+    return m_it->expires();
+}
+
+value_iterator::value_iterator(value_log::snapshot_ptr segments, std::unique_ptr<iterator> it)
+  : m_segments(std::move(segments))
+  , m_it(std::move(it))
+{
+}
+
+void value_iterator::load()
+{
+    uint32_t size = std::min(value_log::read_size, m_pointer.size - m_offset);
+
+    m_value.resize(size);
+    m_segment->read(m_pointer.offset + m_offset, m_value.data(), size);
+
+    m_offset += size;
+    m_crc = crc32c_update(m_crc, m_value.data(), size);
+
+    if (m_offset == m_pointer.size && m_crc != m_pointer.crc)
+    {
+        throw value_log::error("value log segment {}: checksum mismatch", m_segment->id());
+    }
+}
+
+std::unique_ptr<iterator> ushard::range(const std::string_view& min_key,
+                                        const std::string_view& max_key)
+{
+    auto&& version = get_version();
+    auto&& it = std::make_unique<ushard_iterator>(*version,
+                                                  get_memtables(),
+                                                  min_key,
+                                                  max_key,
+                                                  false,
+                                                  m_merge_operator.get());
+
+    return resolve(m_value_log.snapshot(), std::move(it));
+}
+
+std::unique_ptr<iterator> ushard::begin()
+{
+    auto&& version = get_version();
+    auto&& it = std::make_unique<ushard_iterator>(*version,
+                                                  get_memtables(),
+                                                  m_merge_operator.get());
+
+    return resolve(m_value_log.snapshot(), std::move(it));
+}
+
+std::unique_ptr<iterator> ushard::get(const std::string_view& key)
+{
+    if (m_merge_operator != nullptr)
+    {
+        return range(key, key);
+    }
+
+    auto&& segments = m_value_log.snapshot();
+    auto&& version = get_version();
+
+    uint64_t key_hash = bloom_filter::hash(key);
+    uint32_t now = ushard::now();
+
+    slice_ptr best_slice;
+    std::unique_ptr<iterator> best_it;
+
+    for (auto&& memtable : get_memtables())
+    {
+        auto&& it = memtable->range(key);
+
+        if (it->next() == false || skip_expired(it.get(), now) == false)
+        {
+            continue;
+        }
+
+        if (it->key().compare(key) != 0)
+        {
+            continue;
+        }
+
+        if (best_it == nullptr || it->idx() > best_it->idx())
+        {
+            best_it = std::move(it);
+        }
+    }
+
+    for (auto&& slice : *version)
+    {
+        if (best_it != nullptr && best_it->idx() >= slice->max_idx())
+        {
+            break;
+        }
+
+        if (slice->overlaps(key, key) == false)
+        {
+            continue;
+        }
+
+        if (slice->may_contain(key_hash) == false)
+        {
+            continue;
+        }
+
+        auto&& it = slice->range(key, key);
+
+        if (it == nullptr)
+        {
+            continue;
+        }
+
+        if (it->next() == false || skip_expired(it.get(), now) == false)
+        {
+            continue;
+        }
+
+        if (it->key().compare(key) != 0)
+        {
+            continue;
+        }
+
+        if (best_it == nullptr || it->idx() > best_it->idx())
+        {
+            best_slice = slice;
+            best_it = std::move(it);
+        }
+    }
+
+    if (best_it == nullptr)
+    {
+        return std::make_unique<point_iterator>();
+    }
+
+    auto&& it = std::make_unique<point_iterator>(std::move(best_slice), std::move(best_it));
+
+    return resolve(std::move(segments), std::move(it));
+}
+
+std::unique_ptr<iterator> ushard::multi_get(slice::key_views_t keys)
+{
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    slice::iterators_t iterators;
+    iterators.reserve(keys.size());
+
+    if (m_merge_operator != nullptr)
+    {
+        for (auto&& key : keys)
+        {
+            iterators.push_back(range(key, key));
+        }
+
+        return std::make_unique<chain_iterator>(std::move(iterators));
+    }
+
+    auto&& segments = m_value_log.snapshot();
+    auto&& version = get_version();
+    auto&& memtables = get_memtables();
+
+    auto& slices = *version;
+
+    uint32_t now = ushard::now();
+
+    bloom_filter::hashes_t key_hashes;
+    key_hashes.reserve(keys.size());
+
+    for (auto&& key : keys)
+    {
+        key_hashes.push_back(bloom_filter::hash(key));
+    }
+
+    std::vector<slice::iterators_t> slice_iterators(slices.size());
+
+    auto jobs = gt::async::create_jobs();
+
+    for (uint32_t i = 0; i < slices.size(); i++)
+    {
+        auto f = [&slices, &keys, &key_hashes, &slice_iterators, now, i]
+        {
+            auto&& its = slices[i]->multi_get(keys, key_hashes);
+
+            for (uint32_t ndx = 0; ndx < its.size(); ndx++)
+            {
+                auto& it = its[ndx];
+
+                if (it == nullptr)
+                {
+                    continue;
+                }
+
+                if (it->next() == false || skip_expired(it.get(), now) == false)
+                {
+                    it.reset();
+                    continue;
+                }
+
+                if (it->key().compare(keys[ndx]) != 0)
+                {
+                    it.reset();
+                }
+            }
+
+            slice_iterators[i] = std::move(its);
+        };
+
+        jobs.run(std::move(f));
+    }
+
+    jobs.wait();
+
+    for (uint32_t ndx = 0; ndx < keys.size(); ndx++)
+    {
+        auto& key = keys[ndx];
+
+        slice_ptr best_slice;
+        std::unique_ptr<iterator> best_it;
+
+        for (auto&& memtable : memtables)
+        {
+            auto&& it = memtable->range(key);
+
+            if (it->next() == false || skip_expired(it.get(), now) == false)
+            {
+                continue;
+            }
+
+            if (it->key().compare(key) != 0)
+            {
+                continue;
+            }
+
+            if (best_it == nullptr || it->idx() > best_it->idx())
+            {
+                best_it = std::move(it);
+            }
+        }
+
+        for (uint32_t i = 0; i < slices.size(); i++)
+        {
+            auto& it = slice_iterators[i][ndx];
+
+            if (it == nullptr)
+            {
+                continue;
+            }
+
+            if (best_it == nullptr || it->idx() > best_it->idx())
+            {
+                best_slice = slices[i];
+                best_it = std::move(it);
+            }
+        }
+
+        if (best_it == nullptr)
+        {
+            continue;
+        }
+
+        iterators.push_back(std::make_unique<point_iterator>(std::move(best_slice),
+                                                             std::move(best_it)));
+    }
+
+    auto&& it = std::make_unique<chain_iterator>(std::move(iterators));
+
+    return resolve(std::move(segments), std::move(it));
+}
+
+uint64_t ushard::count(const std::string_view& min_key, const std::string_view& max_key)
+{
+    auto&& version = get_version();
+
+    uint64_t key_count = 0;
+
+    for (auto&& slice : *version)
+    {
+        key_count += slice->count(min_key, max_key);
+    }
+
+    return key_count;
+}
+
+uint64_t ushard::estimate_count(const std::string_view& min_key, const std::string_view& max_key)
+{
+    auto&& version = get_version();
+
+    uint64_t key_count = 0;
+
+    for (auto&& slice : *version)
+    {
+        key_count += slice->estimate_count(min_key, max_key);
+    }
+
+    return key_count;
+}
+
+void ushard::ingester::add(const std::string_view& key,
+                           const std::string_view& value,
+                           bool eor,
+                           bool deleted,
+                           uint64_t idx,
+                           uint32_t expires)
+{
+    assert(likely(m_commited == false));
+
+    if (m_target == nullptr)
+    {
+        if (m_run.size() != 0 && key.compare(m_run.back()->max_key()) <= 0)
+        {
+            throw slice_writer::invalid_data_error("input keys not sorted");
+        }
+
+        m_target = std::make_unique<slice_writer>();
+
+        if (m_values != nullptr)
+        {
+            m_target->set_value_log(m_values.get(), m_ushard->m_value_threshold);
+        }
+    }
+
+    m_target->add(key, value, eor, deleted, idx, expires);
+
+    if (eor == true && m_target->size() >= max_ingest_slice_size)
+    {
+        finish();
+    }
+}
+
+uint64_t ushard::ingester::commit(meta_callback* cb)
+{
+    assert(likely(m_commited == false));
+
+    finish();
+
+    value_log::segment_ptr segment;
+
+    if (m_values != nullptr && m_values->size() != 0)
+    {
+        segment = m_values->commit();
+
+        m_ushard->m_value_log.add(segment);
+        cb->add_segment(segment);
+    }
+
+    uint64_t key_count = m_ushard->key_count(m_run);
+
+    if (m_run.size() != 0)
+    {
+        uint32_t level = m_ushard->m_policy->ingest_level(m_run, m_ushard->m_levels);
+        m_ushard->add(level, std::move(m_run), cb);
+    }
+
+    m_commited = true;
+
+    if (segment != nullptr)
+    {
+        m_ushard->m_value_log.publish(segment->id());
+    }
+
+    return key_count;
+}
+
+ushard::ingester::ingester(ushard* ushard)
+  : m_ushard(ushard)
+{
+    if (m_ushard->m_value_threshold != 0 && m_ushard->m_merge_operator == nullptr)
+    {
+        m_values = m_ushard->m_value_log.create_writer();
+    }
+}
+
+ushard::ingester::~ingester()
+{
+    if (m_commited == true)
+    {
+        return;
+    }
+
+    for (auto&& slice : m_run)
+    {
+        slice->unlink();
+    }
+}
+
+void ushard::ingester::finish()
+{
+    if (m_target == nullptr)
+    {
+        return;
+    }
+
+    m_target->flush();
+
+    auto&& slice = m_target->commit();
+    m_target.reset();
+
+    if (slice->key_count() == 0)
+    {
+        slice->unlink();
+        return;
+    }
+
+    m_run.emplace_back(std::move(slice));
+}
+
+std::unique_ptr<ushard::ingester> ushard::ingest()
+{
+    return std::make_unique<ingester>(this);
+}
+
+void ushard::add(slice_ptr slice, meta_callback* cb)
+{
+    add(0, slices_t{std::move(slice)}, cb);
+}
+
+void ushard::restore(uint32_t level, slices_t run)
+{
+    m_policy->insert(m_policy->level_of(level, run), std::move(run), &m_levels);
+
+    update_version();
+}
+
+void ushard::restore(value_log::segment_ptr segment)
+{
+    m_value_log.restore(std::move(segment));
+}
+
+void ushard::write(const std::string_view& key,
+                   const std::string_view& value,
+                   bool eor,
+                   bool deleted,
+                   uint64_t idx,
+                   uint32_t expires)
+{
+    check(key, value, eor, deleted);
+    m_memtable->add(key, value, eor, deleted, idx, expires);
+}
+
+void ushard::seal(bool force, meta_callback* cb)
+{
+    if (m_memtable->size() == 0)
+    {
+        return;
+    }
+
+    if (force == false && m_memtable->size() < max_memtable_size)
+    {
+        return;
+    }
+
+    m_sealed.emplace_back(std::move(m_memtable));
+    m_memtable = std::make_shared<memtable>();
+
+    cb->flush();
+}
+
+uint64_t ushard::flush(meta_callback* cb)
+{
+    std::unique_lock<gt::mutex> lock(m_flush_lock);
+
+    uint64_t key_count = 0;
+
+    while (m_sealed.size() != 0)
+    {
+        ushard_iterator it(slices_t(),
+                           memtables_t{m_sealed.front()},
+                           m_merge_operator.get());
+
+        slice_writer target;
+
+        std::unique_ptr<value_log::writer> values;
+
+        if (m_value_threshold != 0 && m_merge_operator == nullptr)
+        {
+            values = m_value_log.create_writer();
+            target.set_value_log(values.get(), m_value_threshold);
+        }
+
+        target.add(&it, false);
+        target.flush();
+
+        auto&& slice = target.commit();
+        key_count += slice->key_count();
+
+        value_log::segment_ptr segment;
+
+        if (values != nullptr && values->size() != 0)
+        {
+            segment = values->commit();
+
+            m_value_log.add(segment);
+            cb->add_segment(segment);
+        }
+
+        if (slice->key_count() != 0)
+        {
+            add(0, slices_t{std::move(slice)}, cb);
+        }
+        else
+        {
+            slice->unlink();
+        }
+
+        if (segment != nullptr)
+        {
+            m_value_log.publish(segment->id());
+        }
+
+        m_sealed.erase(m_sealed.begin());
+    }
+
+    return key_count;
+}
+
+uint64_t ushard::merge(uint32_t level, meta_callback* cb)
+{
+    return merge(m_policy->plan(level, m_levels), cb);
+}
+
+uint64_t ushard::compact(meta_callback* cb)
+{
+    auto&& task = m_policy->plan_compaction(m_levels);
+
+    if (task.slices.size() < 2)
+    {
+        return 0;
+    }
+
+    return merge(std::move(task), cb);
+}
+
+uint64_t ushard::expire(meta_callback* cb)
+{
+    uint32_t now = ushard::now();
+
+    slices_t slices;
+
+    for (auto&& slice : *m_version)
+    {
+        if (slice->max_expires() > now)
+        {
+            continue;
+        }
+
+        if (m_merging.find(slice.get()) != m_merging.end())
+        {
+            continue;
+        }
+
+        slices.push_back(slice);
+    }
+
+    if (slices.size() == 0)
+    {
+        return 0;
+    }
+
+    remove(slices, cb);
+
+    return key_count(slices);
+}
+
+void ushard::drop()
+{
+    m_dropped = true;
+}
+
+void ushard::set_merge_operator(merge_operator_ptr merge_operator)
+{
+    m_merge_operator = std::move(merge_operator);
+}
+
+void ushard::set_value_threshold(uint32_t value_threshold)
+{
+    m_value_threshold = value_threshold;
+}
+
+ushard::slices_t ushard::get_slices() const
+{
+    return *m_version;
+}
+
+ushard::version_ptr ushard::get_version() const
+{
+    return m_version;
+}
+
+value_log::segments_t ushard::get_segments() const
+{
+    return m_value_log.segments();
+}
+
+void ushard::check(const std::string_view& key,
+                   const std::string_view& value,
+                   bool eor,
+                   bool deleted)
+{
+    if (key.size() == 0)
+    {
+        throw slice_writer::invalid_data_error("key of zero length not allowed");
+    }
+
+    if (key.size() >= node::max_key_size)
+    {
+        throw slice_writer::invalid_data_error("maximum key size exceded");
+    }
+
+    if (deleted == true)
+    {
+        if (eor == false || value.size() != 0)
+        {
+            throw slice_writer::invalid_data_error("invalid combination of key attributes");
+        }
+    }
+}
+
+uint32_t ushard::now()
+{
+    return clock::realtime() / 1000000000;
+}
+
+ushard::memtables_t ushard::get_memtables() const
+{
+    memtables_t memtables(m_sealed);
+    memtables.push_back(m_memtable);
+
+    return memtables;
+}
+
+std::unique_ptr<iterator> ushard::resolve(value_log::snapshot_ptr segments,
+                                          std::unique_ptr<iterator> it) const
+{
+    if (segments->empty() == true)
+    {
+        return it;
+    }
+
+    return std::make_unique<value_iterator>(std::move(segments), std::move(it));
+}
+
+ushard::ushard(std::unique_ptr<compaction_policy> policy)
+  : m_policy(std::move(policy))
+{
+}
+
+ushard::ushard()
+  : ushard(compaction_policy::create(compaction_policy::type::tiered))
+{
+}
+
+ushard::~ushard()
+{
+    if (m_dropped == false)
+    {
+        return;
+    }
+
+    for (auto&& slice : *m_version)
+    {
+        slice->unlink();
+    }
+
+    for (auto&& segment : m_value_log.segments())
+    {
+        segment->unlink();
+    }
+
+    m_levels.clear();
+}
+
+uint64_t ushard::key_count(const slices_t& slices)
+{
+    return compaction_policy::key_count(slices);
+}
+
+slice::keys_t ushard::partition_keys(const slices_t& slices)
+{
+    slice::keys_t keys;
+
+    uint32_t partitions = std::min(static_cast<uint64_t>(max_partitions),
+                                   key_count(slices) / min_partition_key_count);
+
+    if (partitions < 2)
+    {
+        return keys;
+    }
+
+    auto&& largest = std::max_element(slices.begin(), slices.end(), [](auto&& s1, auto&& s2)
+    {
+        return s1->key_count() < s2->key_count();
+    });
+
+    auto&& root_keys = (*largest)->root_keys();
+    partitions = std::min(partitions, static_cast<uint32_t>(root_keys.size()));
+
+    for (uint32_t ndx = 1; ndx < partitions; ndx++)
+    {
+        auto&& key = root_keys[ndx * root_keys.size() / partitions];
+
+        if (keys.size() != 0 && keys.back().compare(key) == 0)
+        {
+            continue;
+        }
+
+        keys.emplace_back(std::move(key));
+    }
+
+    return keys;
+}
+
+ushard::slices_t ushard::merge(const slices_t& slices, bool compact)
+{
+    static const std::string key_limit(node::max_key_size - 1, '\xff');
+
+    auto&& keys = partition_keys(slices);
+    uint32_t partitions = keys.size() + 1;
+
+    slices_t run(partitions);
+
+    auto jobs = gt::async::create_jobs();
+
+    for (uint32_t ndx = 0; ndx < partitions; ndx++)
+    {
+        auto f = [this, &slices, &keys, &run, ndx, partitions, compact]
+        {
+            std::unique_ptr<ushard_iterator> it;
+
+            if (partitions == 1)
+            {
+                it = std::make_unique<ushard_iterator>(slices,
+                                                       memtables_t(),
+                                                       m_merge_operator.get());
+            }
+            else
+            {
+                bool is_last = ndx == partitions - 1;
+
+                std::string_view min_key = ndx != 0 ? keys[ndx - 1] : std::string_view();
+                std::string_view max_key = is_last == false ? keys[ndx] : key_limit;
+
+                it = std::make_unique<ushard_iterator>(slices,
+                                                       memtables_t(),
+                                                       min_key,
+                                                       max_key,
+                                                       is_last == false,
+                                                       m_merge_operator.get());
+            }
+
+            slice_writer target;
+
+            target.add(it.get(), compact);
+            target.flush();
+
+            run[ndx] = target.commit();
+        };
+
+        jobs.run(std::move(f));
+    }
+
+    jobs.wait();
+
+    slices_t target_run;
+    target_run.reserve(partitions);
+
+    for (auto&& slice : run)
+    {
+        if (slice->key_count() == 0)
+        {
+            slice->unlink();
+            continue;
+        }
+
+        target_run.emplace_back(std::move(slice));
+    }
+
+    return target_run;
+}
+
+uint64_t ushard::merge(compaction_policy::task task, meta_callback* cb)
+{
+    if (task.slices.size() == 0)
+    {
+        return 0;
+    }
+
+    for (auto&& slice : task.slices)
+    {
+        if (m_merging.find(slice.get()) != m_merging.end())
+        {
+            return 0;
+        }
+    }
+
+    for (auto&& slice : task.slices)
+    {
+        m_merging.insert(slice.get());
+    }
+
+    auto&& unmark = [this, &task]
+    {
+        for (auto&& slice : task.slices)
+        {
+            m_merging.erase(slice.get());
+        }
+    };
+
+    auto source_key_count = key_count(task.slices);
+
+    try
+    {
+        uint32_t now = ushard::now();
+
+        slices_t expired;
+        slices_t live;
+
+        for (auto&& slice : task.slices)
+        {
+            (slice->max_expires() <= now ? expired : live).push_back(slice);
+        }
+
+        if (expired.size() != 0)
+        {
+            remove(expired, cb);
+        }
+
+        if (live.size() != 0 && task.rewrite == true)
+        {
+            auto&& run = merge(live, task.compact);
+
+            add(task.level, std::move(run), cb);
+            remove(live, cb);
+        }
+        else if (live.size() != 0)
+        {
+            slices_t run;
+            slices_t rewritten;
+
+            for (auto&& group : overlapping_groups(std::move(live)))
+            {
+                bool is_movable = group.size() == 1;
+
+                if (task.compact == true && group.front()->deleted_count() != 0)
+                {
+                    is_movable = false;
+                }
+
+                if (is_movable == true)
+                {
+                    run.push_back(std::move(group.front()));
+                    continue;
+                }
+
+                auto&& group_run = merge(group, task.compact);
+
+                std::move(group_run.begin(), group_run.end(), std::back_inserter(run));
+                std::move(group.begin(), group.end(), std::back_inserter(rewritten));
+            }
+
+            std::sort(run.begin(), run.end(), [](auto&& s1, auto&& s2)
+            {
+                return s1->min_key().compare(s2->min_key()) < 0;
+            });
+
+            add(task.level, std::move(run), cb);
+
+            if (rewritten.size() != 0)
+            {
+                remove(rewritten, cb);
+            }
+        }
+    }
+    catch (...)
+    {
+        unmark();
+        throw;
+    }
+
+    unmark();
+
+    return source_key_count;
+}
+
+void ushard::add(uint32_t level, slices_t run, meta_callback* cb)
+{
+    if (run.size() == 0)
+    {
+        return;
+    }
+
+    level = m_policy->level_of(level, run);
+
+    cb->add(level, run);
+
+    detach(run);
+    m_policy->insert(level, std::move(run), &m_levels);
+
+    update_version();
+
+    if (m_policy->needs_merge(level, m_levels) == true)
+    {
+        cb->merge(level);
+    }
+}
+
+void ushard::remove(const slices_t& slices, meta_callback* cb)
+{
+    detach(slices);
+
+    std::vector<uint32_t> levels;
+
+    for (auto&& it : m_levels)
+    {
+        if (m_policy->needs_merge(it.first, m_levels) == true)
+        {
+            levels.push_back(it.first);
+        }
+    }
+
+    cb->remove(slices);
+
+    collect_segments(cb);
+
+    for (auto&& level : levels)
+    {
+        cb->merge(level);
+    }
+}
+
+void ushard::detach(const slices_t& slices)
+{
+    auto&& is_removed = [&slices](const slice_ptr& slice)
+    {
+        return std::find(slices.begin(), slices.end(), slice) != slices.end();
+    };
+
+    auto&& is_empty = [](const slices_t& run)
+    {
+        return run.size() == 0;
+    };
+
+    for (auto&& it : m_levels)
+    {
+        auto& runs = it.second;
+
+        for (auto&& run : runs)
+        {
+            run.erase(std::remove_if(run.begin(), run.end(), is_removed), run.end());
+        }
+
+        runs.erase(std::remove_if(runs.begin(), runs.end(), is_empty), runs.end());
+    }
+
+    update_version();
+}
+
+void ushard::update_version()
+{
+    auto slices = std::make_shared<slices_t>();
+
+    for (auto&& it : m_levels)
+    {
+        for (auto&& run : it.second)
+        {
+            std::copy(run.begin(),
+                      run.end(),
+                      std::back_inserter(*slices));
+        }
+    }
+
+    std::sort(slices->begin(), slices->end(), [](auto&& s1, auto&& s2)
+    {
+        return s1->max_idx() > s2->max_idx();
+    });
+
+    m_version = std::move(slices);
+}
+
+ushard::runs_t ushard::overlapping_groups(slices_t slices)
+{
+    std::sort(slices.begin(), slices.end(), [](auto&& s1, auto&& s2)
+    {
+        return s1->min_key().compare(s2->min_key()) < 0;
+    });
+
+    runs_t groups;
+    std::string_view max_key;
+
+    for (auto&& slice : slices)
+    {
+        if (groups.size() == 0 || slice->min_key().compare(max_key) > 0)
+        {
+            groups.emplace_back();
+            max_key = slice->max_key();
+        }
+        else if (slice->max_key().compare(max_key) > 0)
+        {
+            max_key = slice->max_key();
+        }
+
+        groups.back().push_back(std::move(slice));
+    }
+
+    return groups;
+}
+
+void ushard::collect_segments(meta_callback* cb)
+{
+    if (m_value_log.empty() == true)
+    {
+        return;
+    }
+
+    value_log::segment_ids_t ids;
+
+    for (auto&& slice : *m_version)
+    {
+        auto& slice_ids = slice->segments();
+        ids.insert(ids.end(), slice_ids.begin(), slice_ids.end());
+    }
+
+    std::sort(ids.begin(), ids.end());
+
+    auto&& segments = m_value_log.collect(ids);
+
+    if (segments.size() == 0)
+    {
+        return;
+    }
+
+    cb->remove_segments(segments);
 
-    if (tier_slices.size() > max_slices_per_tier)
+    for (auto&& segment : segments)
     {
-        cb->merge(tier);
+        segment->unlink();
     }
 }
 
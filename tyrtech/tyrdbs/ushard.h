@@ -1,7 +1,12 @@
 #pragma once
 
 
+#include <gt/mutex.h>
 #include <tyrdbs/slice_writer.h>
+#include <tyrdbs/memtable.h>
+#include <tyrdbs/compaction_policy.h>
+
+#include <unordered_set>
 
 
 namespace tyrtech::tyrdbs {
@@ -10,7 +15,10 @@ namespace tyrtech::tyrdbs {
 class ushard : private disallow_copy, disallow_move
 {
 public:
-    static constexpr uint32_t max_slices_per_tier{4};
+    static constexpr uint32_t max_partitions{8};
+    static constexpr uint64_t min_partition_key_count{1UL << 16};
+    static constexpr uint64_t max_memtable_size{32UL << 20};
+    static constexpr uint64_t max_ingest_slice_size{256UL << 20};
 
 public:
     using slice_ptr =
@@ -19,50 +27,178 @@ public:
     using slices_t =
             std::vector<slice_ptr>;
 
+    using version_ptr =
+            std::shared_ptr<const slices_t>;
+
+    using memtable_ptr =
+            std::shared_ptr<memtable>;
+
+    using memtables_t =
+            std::vector<memtable_ptr>;
+
 public:
     struct meta_callback
     {
-        virtual void add(const slice_ptr& slice) = 0;
+        virtual void add(uint32_t level, const slices_t& slices) = 0;
         virtual void remove(const slices_t& slices) = 0;
 
-        virtual void merge(uint16_t tier) = 0;
+        virtual void add_segment(const value_log::segment_ptr& segment) = 0;
+        virtual void remove_segments(const value_log::segments_t& segments) = 0;
+
+        virtual void merge(uint16_t level) = 0;
+        virtual void flush() = 0;
 
         virtual ~meta_callback() = default;
     };
 
+    struct merge_operator
+    {
+        virtual void merge(const std::string_view& key,
+                           const std::string_view& older_value,
+                           std::string* value) const = 0;
+        virtual void truncate(const std::string_view& key, std::string* value) const = 0;
+
+        virtual ~merge_operator() = default;
+    };
+
+    using merge_operator_ptr =
+            std::shared_ptr<merge_operator>;
+
+public:
+    class ingester : private disallow_copy, disallow_move
+    {
+    public:
+        void add(const std::string_view& key,
+                 const std::string_view& value,
+                 bool eor,
+                 bool deleted,
+                 uint64_t idx,
+                 uint32_t expires);
+
+        uint64_t commit(meta_callback* cb);
+
+    public:
+        ingester(ushard* ushard);
+        ~ingester();
+
+    private:
+        ushard* m_ushard{nullptr};
+
+        std::unique_ptr<value_log::writer> m_values;
+        std::unique_ptr<slice_writer> m_target;
+
+        slices_t m_run;
+
+        bool m_commited{false};
+
+    private:
+        void finish();
+    };
+
 public:
     std::unique_ptr<iterator> range(const std::string_view& min_key,
                                     const std::string_view& max_key);
     std::unique_ptr<iterator> begin();
+    std::unique_ptr<iterator> get(const std::string_view& key);
+    std::unique_ptr<iterator> multi_get(slice::key_views_t keys);
+
+    uint64_t count(const std::string_view& min_key, const std::string_view& max_key);
+    uint64_t estimate_count(const std::string_view& min_key, const std::string_view& max_key);
+
+    std::unique_ptr<ingester> ingest();
 
     void add(slice_ptr slice, meta_callback* cb);
+    void restore(uint32_t level, slices_t run);
+    void restore(value_log::segment_ptr segment);
+
+    void write(const std::string_view& key,
+               const std::string_view& value,
+               bool eor,
+               bool deleted,
+               uint64_t idx,
+               uint32_t expires);
+
+    void seal(bool force, meta_callback* cb);
+    uint64_t flush(meta_callback* cb);
 
-    uint64_t merge(uint32_t tier, meta_callback* cb);
+    uint64_t merge(uint32_t level, meta_callback* cb);
     uint64_t compact(meta_callback* cb);
+    uint64_t expire(meta_callback* cb);
 
     void drop();
 
+    void set_merge_operator(merge_operator_ptr merge_operator);
+    void set_value_threshold(uint32_t value_threshold);
+
     slices_t get_slices() const;
+    version_ptr get_version() const;
+    value_log::segments_t get_segments() const;
 
 public:
+    static void check(const std::string_view& key,
+                      const std::string_view& value,
+                      bool eor,
+                      bool deleted);
+
+    static uint32_t now();
+
+public:
+    ushard(std::unique_ptr<compaction_policy> policy);
+    ushard();
+
     ~ushard();
 
 private:
-    using tier_map_t =
-            std::unordered_map<uint32_t, slices_t>;
+    using levels_t =
+            compaction_policy::levels_t;
+
+    using runs_t =
+            compaction_policy::runs_t;
+
+    using merging_t =
+            std::unordered_set<const slice*>;
 
 private:
-    tier_map_t m_tier_map;
+    std::unique_ptr<compaction_policy> m_policy;
+    merge_operator_ptr m_merge_operator;
+
+    value_log m_value_log;
+    uint32_t m_value_threshold{0};
+
+    levels_t m_levels;
+    merging_t m_merging;
+
+    version_ptr m_version{std::make_shared<const slices_t>()};
+
     bool m_dropped{false};
 
+    memtable_ptr m_memtable{std::make_shared<memtable>()};
+    memtables_t m_sealed;
+
+    gt::mutex m_flush_lock;
+
 private:
-    uint32_t tier_of(const slice_ptr& slice);
+    memtables_t get_memtables() const;
+
+    std::unique_ptr<iterator> resolve(value_log::snapshot_ptr segments,
+                                      std::unique_ptr<iterator> it) const;
 
-    slices_t get_slices_for(uint32_t tier);
     uint64_t key_count(const slices_t& slices);
 
-    void add(slice_ptr slice, meta_callback* cb, bool use_add_callback);
-    void remove_from(uint32_t tier, uint32_t count, meta_callback* cb);
+    slice::keys_t partition_keys(const slices_t& slices);
+    slices_t merge(const slices_t& slices, bool compact);
+
+    uint64_t merge(compaction_policy::task task, meta_callback* cb);
+
+    void add(uint32_t level, slices_t run, meta_callback* cb);
+    void remove(const slices_t& slices, meta_callback* cb);
+    void detach(const slices_t& slices);
+
+    void update_version();
+
+    void collect_segments(meta_callback* cb);
+
+    static runs_t overlapping_groups(slices_t slices);
 };
 
 }
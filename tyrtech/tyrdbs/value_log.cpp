@@ -0,0 +1,210 @@
+#include <common/branch_prediction.h>
+#include <tyrdbs/value_log.h>
+
+#include <crc32c.h>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+
+namespace tyrtech::tyrdbs {
+
+
+void value_log::segment::read(uint64_t offset, char* data, uint32_t size) const
+{
+    if (m_reader.pread(offset, data, size) != size)
+    {
+        throw error("value log segment {} too short", m_id);
+    }
+}
+
+void value_log::segment::unlink()
+{
+    assert(likely(m_unlink == false));
+    m_unlink = true;
+}
+
+uint64_t value_log::segment::id() const
+{
+    return m_id;
+}
+
+const storage::file_descriptor& value_log::segment::descriptor() const
+{
+    return m_reader.descriptor();
+}
+
+value_log::segment::segment(uint64_t id, storage::file_reader&& reader)
+  : m_id(id)
+  , m_reader(std::move(reader))
+{
+}
+
+value_log::segment::~segment()
+{
+    if (m_unlink == true)
+    {
+        m_reader.unlink();
+    }
+}
+
+value_log::pointer value_log::writer::write(const std::string_view& data)
+{
+    pointer p;
+
+    p.segment = m_id;
+    p.offset = m_writer.size();
+
+    append(&p, data);
+
+    return p;
+}
+
+void value_log::writer::append(pointer* pointer, const std::string_view& data)
+{
+    assert(likely(pointer->segment == m_id));
+    assert(likely(pointer->offset + pointer->size == m_writer.size()));
+
+    m_writer.write(data.data(), data.size());
+
+    pointer->size += data.size();
+    pointer->crc = crc32c_update(pointer->crc, data.data(), data.size());
+}
+
+uint32_t value_log::writer::size() const
+{
+    return m_writer.size();
+}
+
+value_log::segment_ptr value_log::writer::commit()
+{
+    assert(likely(m_writer.size() != 0));
+
+    m_writer.add_padding();
+    m_writer.flush();
+
+    return std::make_shared<segment>(m_id, storage::create_reader(m_writer.commit()));
+}
+
+value_log::writer::writer(uint64_t id)
+  : m_id(id)
+  , m_writer(storage::create_writer())
+{
+}
+
+std::unique_ptr<value_log::writer> value_log::create_writer()
+{
+    return std::make_unique<writer>(m_next_id++);
+}
+
+void value_log::add(segment_ptr segment)
+{
+    m_pending.insert(segment->id());
+    restore(std::move(segment));
+}
+
+void value_log::publish(uint64_t id)
+{
+    m_pending.erase(id);
+}
+
+void value_log::restore(segment_ptr segment)
+{
+    auto segments = std::make_shared<segment_map_t>(*m_segments);
+
+    m_next_id = std::max(m_next_id, segment->id() + 1);
+    (*segments)[segment->id()] = std::move(segment);
+
+    m_segments = std::move(segments);
+}
+
+value_log::segments_t value_log::collect(const segment_ids_t& live_ids)
+{
+    segments_t dead;
+
+    for (auto&& it : *m_segments)
+    {
+        if (std::binary_search(live_ids.begin(), live_ids.end(), it.first) == true)
+        {
+            continue;
+        }
+
+        if (m_pending.count(it.first) != 0)
+        {
+            continue;
+        }
+
+        dead.push_back(it.second);
+    }
+
+    if (dead.size() == 0)
+    {
+        return dead;
+    }
+
+    auto segments = std::make_shared<segment_map_t>(*m_segments);
+
+    for (auto&& segment : dead)
+    {
+        segments->erase(segment->id());
+    }
+
+    m_segments = std::move(segments);
+
+    return dead;
+}
+
+value_log::segments_t value_log::segments() const
+{
+    segments_t segments;
+    segments.reserve(m_segments->size());
+
+    for (auto&& it : *m_segments)
+    {
+        segments.push_back(it.second);
+    }
+
+    return segments;
+}
+
+value_log::snapshot_ptr value_log::snapshot() const
+{
+    return m_segments;
+}
+
+bool value_log::empty() const
+{
+    return m_segments->empty();
+}
+
+value_log::segment_ptr value_log::get(const snapshot_ptr& snapshot, uint64_t id)
+{
+    auto it = snapshot->find(id);
+
+    if (it == snapshot->end())
+    {
+        throw error("value log segment {} not found", id);
+    }
+
+    return it->second;
+}
+
+std::string_view value_log::encode(const pointer& pointer)
+{
+    return std::string_view(reinterpret_cast<const char*>(&pointer), sizeof(pointer));
+}
+
+value_log::pointer value_log::decode(const std::string_view& data)
+{
+    if (data.size() != sizeof(pointer))
+    {
+        throw error("invalid value pointer");
+    }
+
+    pointer p;
+    std::memcpy(&p, data.data(), sizeof(p));
+
+    return p;
+}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+
+#include <storage/engine.h>
+
+#include <map>
+#include <set>
+#include <memory>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class value_log : private disallow_copy, disallow_move
+{
+public:
+    DEFINE_EXCEPTION(runtime_error, error);
+
+public:
+    static constexpr uint32_t read_size{65536};
+
+public:
+    struct pointer
+    {
+        uint64_t segment{0};
+        uint64_t offset{0};
+        uint32_t size{0};
+        uint32_t crc{0};
+    } __attribute__ ((packed));
+
+public:
+    class segment : private disallow_copy, disallow_move
+    {
+    public:
+        void read(uint64_t offset, char* data, uint32_t size) const;
+
+        void unlink();
+
+        uint64_t id() const;
+        const storage::file_descriptor& descriptor() const;
+
+    public:
+        segment(uint64_t id, storage::file_reader&& reader);
+        ~segment();
+
+    private:
+        uint64_t m_id{0};
+        storage::file_reader m_reader;
+
+        bool m_unlink{false};
+    };
+
+    using segment_ptr =
+            std::shared_ptr<segment>;
+
+    using segments_t =
+            std::vector<segment_ptr>;
+
+    using segment_ids_t =
+            std::vector<uint64_t>;
+
+    using segment_map_t =
+            std::map<uint64_t, segment_ptr>;
+
+    using snapshot_ptr =
+            std::shared_ptr<const segment_map_t>;
+
+public:
+    class writer : private disallow_copy, disallow_move
+    {
+    public:
+        pointer write(const std::string_view& data);
+        void append(pointer* pointer, const std::string_view& data);
+
+        uint32_t size() const;
+
+        segment_ptr commit();
+
+    public:
+        writer(uint64_t id);
+
+    private:
+        uint64_t m_id{0};
+        storage::file_writer m_writer;
+    };
+
+public:
+    std::unique_ptr<writer> create_writer();
+
+    void add(segment_ptr segment);
+    void publish(uint64_t id);
+    void restore(segment_ptr segment);
+
+    segments_t collect(const segment_ids_t& live_ids);
+    segments_t segments() const;
+
+    snapshot_ptr snapshot() const;
+    bool empty() const;
+
+public:
+    static segment_ptr get(const snapshot_ptr& snapshot, uint64_t id);
+
+    static std::string_view encode(const pointer& pointer);
+    static pointer decode(const std::string_view& data);
+
+private:
+    using pending_t =
+            std::set<uint64_t>;
+
+private:
+    snapshot_ptr m_segments{std::make_shared<segment_map_t>()};
+    pending_t m_pending;
+
+    uint64_t m_next_id{1};
+};
+
+}
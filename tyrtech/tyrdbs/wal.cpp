@@ -0,0 +1,259 @@
+#include <common/branch_prediction.h>
+#include <common/system_error.h>
+#include <tyrdbs/wal.h>
+
+#include <crc32c.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+
+namespace tyrtech::tyrdbs {
+
+
+uint64_t wal::append(const std::string_view& record)
+{
+    record_header h;
+
+    h.size = record.size();
+    h.lsn = m_next_lsn++;
+    h.crc = crc_of(h, record);
+
+    m_buffer.append(reinterpret_cast<const char*>(&h), sizeof(h));
+    m_buffer.append(record.data(), record.size());
+
+    return h.lsn;
+}
+
+void wal::commit(uint64_t lsn)
+{
+    assert(likely(lsn < m_next_lsn));
+
+    while (m_durable_lsn < lsn)
+    {
+        if (m_failed == true)
+        {
+            throw error("{}: log is in failed state", m_path);
+        }
+
+        if (m_flushing == true)
+        {
+            m_flush_cond.wait();
+        }
+        else
+        {
+            flush();
+        }
+    }
+}
+
+void wal::checkpoint(uint64_t lsn)
+{
+    while (m_segments.size() > 1 && m_segments[1].first_lsn <= lsn + 1)
+    {
+        m_segments.front().file.unlink();
+        m_segments.pop_front();
+    }
+}
+
+void wal::replay(replay_callback* cb)
+{
+    for (auto&& s : m_segments)
+    {
+        replay(&s, cb);
+    }
+}
+
+uint64_t wal::last_lsn() const
+{
+    return m_next_lsn - 1;
+}
+
+uint64_t wal::size() const
+{
+    uint64_t size = 0;
+
+    for (auto&& s : m_segments)
+    {
+        size += s.size;
+    }
+
+    return size;
+}
+
+wal::wal(const std::string_view& path)
+  : m_path(path)
+{
+    if (::mkdir(m_path.c_str(), 0750) == -1 && errno != EEXIST)
+    {
+        throw error("{}: {}", m_path, system_error().message);
+    }
+
+    load_segments();
+
+    for (auto&& s : m_segments)
+    {
+        m_next_lsn = std::max(m_next_lsn, std::max(s.first_lsn, replay(&s, nullptr) + 1));
+    }
+
+    if (m_segments.size() != 0 && m_segments.back().first_lsn == m_next_lsn)
+    {
+        m_segments.back().file.unlink();
+        m_segments.pop_back();
+    }
+
+    m_durable_lsn = m_next_lsn - 1;
+
+    create_segment(m_next_lsn);
+}
+
+void wal::flush()
+{
+    assert(likely(m_flush_buffer.size() == 0));
+
+    m_flushing = true;
+
+    std::swap(m_buffer, m_flush_buffer);
+    uint64_t lsn = m_next_lsn - 1;
+
+    try
+    {
+        auto& s = m_segments.back();
+
+        s.file.pwrite(s.size, m_flush_buffer.data(), m_flush_buffer.size());
+        s.file.sync();
+
+        s.size += m_flush_buffer.size();
+        m_flush_buffer.clear();
+
+        m_durable_lsn = lsn;
+
+        if (s.size >= segment_size)
+        {
+            create_segment(m_durable_lsn + 1);
+        }
+    }
+    catch (...)
+    {
+        m_flush_buffer.clear();
+
+        m_failed = true;
+        m_flushing = false;
+        m_flush_cond.signal_all();
+
+        throw;
+    }
+
+    m_flushing = false;
+    m_flush_cond.signal_all();
+}
+
+void wal::load_segments()
+{
+    DIR* dir = ::opendir(m_path.c_str());
+
+    if (dir == nullptr)
+    {
+        throw error("{}: {}", m_path, system_error().message);
+    }
+
+    std::vector<uint64_t> lsns;
+
+    while (auto entry = ::readdir(dir))
+    {
+        uint64_t lsn = 0;
+        char suffix[8];
+
+        if (std::sscanf(entry->d_name, "%16lx%7s", &lsn, suffix) != 2)
+        {
+            continue;
+        }
+
+        if (std::strlen(entry->d_name) != 20 || std::strcmp(suffix, ".wal") != 0)
+        {
+            continue;
+        }
+
+        lsns.push_back(lsn);
+    }
+
+    ::closedir(dir);
+
+    std::sort(lsns.begin(), lsns.end());
+
+    for (auto&& lsn : lsns)
+    {
+        m_segments.push_back(segment{lsn, io::file::open(io::file::access::read_write,
+                                                         "{}/{:016x}.wal",
+                                                         m_path,
+                                                         lsn)});
+    }
+}
+
+void wal::create_segment(uint64_t first_lsn)
+{
+    m_segments.push_back(segment{first_lsn, io::file::create("{}/{:016x}.wal",
+                                                             m_path,
+                                                             first_lsn)});
+
+    io::file::open(io::file::access::read, "{}", m_path).sync();
+}
+
+uint64_t wal::replay(segment* s, replay_callback* cb)
+{
+    uint64_t size = s->file.stat().st_size;
+    s->size = size;
+
+    std::string data(size, '\0');
+
+    if (size != 0)
+    {
+        s->file.pread(0, data.data(), size);
+    }
+
+    uint64_t lsn = s->first_lsn;
+    uint64_t offset = 0;
+
+    while (offset + sizeof(record_header) <= size)
+    {
+        record_header h;
+        std::memcpy(&h, data.data() + offset, sizeof(h));
+
+        offset += sizeof(h);
+
+        if (h.lsn != lsn || h.size > size - offset)
+        {
+            break;
+        }
+
+        std::string_view record(data.data() + offset, h.size);
+
+        if (crc_of(h, record) != h.crc)
+        {
+            break;
+        }
+
+        if (cb != nullptr)
+        {
+            cb->replay(h.lsn, record);
+        }
+
+        offset += h.size;
+        lsn++;
+    }
+
+    return lsn - 1;
+}
+
+uint32_t wal::crc_of(const record_header& header, const std::string_view& record)
+{
+    uint32_t crc = crc32c_update(0,
+                                 reinterpret_cast<const char*>(&header) + sizeof(header.crc),
+                                 sizeof(header) - sizeof(header.crc));
+
+    return crc32c_update(crc, record.data(), record.size());
+}
+
+}
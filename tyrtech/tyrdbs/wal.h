@@ -0,0 +1,90 @@
+#pragma once
+
+
+#include <common/disallow_copy.h>
+#include <common/disallow_move.h>
+#include <common/exception.h>
+#include <gt/condition.h>
+#include <io/file.h>
+
+#include <string>
+#include <deque>
+
+
+namespace tyrtech::tyrdbs {
+
+
+class wal : private disallow_copy, disallow_move
+{
+public:
+    DEFINE_EXCEPTION(runtime_error, error);
+
+public:
+    static constexpr uint64_t segment_size{64UL << 20};
+
+public:
+    struct replay_callback
+    {
+        virtual void replay(uint64_t lsn, const std::string_view& record) = 0;
+    };
+
+public:
+    uint64_t append(const std::string_view& record);
+    void commit(uint64_t lsn);
+
+    void checkpoint(uint64_t lsn);
+    void replay(replay_callback* cb);
+
+    uint64_t last_lsn() const;
+    uint64_t size() const;
+
+public:
+    wal(const std::string_view& path);
+
+private:
+    struct record_header
+    {
+        uint32_t crc{0};
+        uint32_t size{0};
+        uint64_t lsn{0};
+    } __attribute__ ((packed));
+
+private:
+    struct segment
+    {
+        uint64_t first_lsn{0};
+        io::file file;
+
+        uint64_t size{0};
+    };
+
+    using segments_t =
+            std::deque<segment>;
+
+private:
+    std::string m_path;
+
+    segments_t m_segments;
+
+    std::string m_buffer;
+    std::string m_flush_buffer;
+
+    uint64_t m_next_lsn{1};
+    uint64_t m_durable_lsn{0};
+
+    bool m_flushing{false};
+    bool m_failed{false};
+    gt::condition m_flush_cond;
+
+private:
+    void flush();
+
+    void load_segments();
+    void create_segment(uint64_t first_lsn);
+
+    uint64_t replay(segment* s, replay_callback* cb);
+
+    static uint32_t crc_of(const record_header& header, const std::string_view& record);
+};
+
+}